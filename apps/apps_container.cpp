@@ -90,6 +90,8 @@ bool AppsContainer::dispatchEvent(Ion::Events::Event event) {
       App::Snapshot * activeSnapshot = (activeApp() == nullptr ? appSnapshotAtIndex(0) : activeApp()->snapshot());
       switchTo(usbConnectedAppSnapshot());
       Ion::USB::DFU();
+      // The storage might have been written by the DFU transfer
+      Ion::Storage::sharedStorage()->rebuildIndex();
       switchTo(activeSnapshot);
       didProcessEvent = true;
     } else {
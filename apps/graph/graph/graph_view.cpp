@@ -9,6 +9,7 @@ GraphView::GraphView(CartesianFunctionStore * functionStore, InteractiveCurveVie
   CurveViewCursor * cursor, BannerView * bannerView, View * cursorView) :
   FunctionGraphView(graphRange, cursor, bannerView, cursorView),
   m_functionStore(functionStore),
+  m_sampleCache(),
   m_tangent(false)
 {
 }
@@ -23,8 +24,17 @@ void GraphView::reload() {
 
 void GraphView::drawRect(KDContext * ctx, KDRect rect) const {
   FunctionGraphView::drawRect(ctx, rect);
+  Function * cachedFunction = m_selectedFunction;
+  if (cachedFunction == nullptr && m_functionStore->numberOfActiveFunctions() > 0) {
+    cachedFunction = m_functionStore->activeFunctionAtIndex(0);
+  }
   for (int i = 0; i < m_functionStore->numberOfActiveFunctions(); i++) {
     CartesianFunction * f = m_functionStore->activeFunctionAtIndex(i);
+    CurveSampleCache * sampleCache = nullptr;
+    if (f == cachedFunction) {
+      sampleCache = &m_sampleCache;
+      sampleCache->setCurveChecksum(f->checksum());
+    }
 
     /* Draw function (color the area under curve of the selected function) */
     if (f == m_selectedFunction) {
@@ -32,13 +42,21 @@ void GraphView::drawRect(KDContext * ctx, KDRect rect) const {
         CartesianFunction * f = (CartesianFunction *)model;
         Poincare::Context * c = (Poincare::Context *)context;
         return f->evaluateAtAbscissa(t, c);
-      }, f, context(), f->color(), true, m_highlightedStart, m_highlightedEnd);
+      }, [](const float * t, float * results, int numberOfParameters, void * model, void * context) {
+        CartesianFunction * f = (CartesianFunction *)model;
+        Poincare::Context * c = (Poincare::Context *)context;
+        f->evaluateAtAbscissae(t, results, numberOfParameters, c);
+      }, f, context(), f->color(), true, m_highlightedStart, m_highlightedEnd, false, sampleCache);
     } else {
       drawCurve(ctx, rect, [](float t, void * model, void * context) {
         CartesianFunction * f = (CartesianFunction *)model;
         Poincare::Context * c = (Poincare::Context *)context;
         return f->evaluateAtAbscissa(t, c);
-      }, f, context(), f->color());
+      }, [](const float * t, float * results, int numberOfParameters, void * model, void * context) {
+        CartesianFunction * f = (CartesianFunction *)model;
+        Poincare::Context * c = (Poincare::Context *)context;
+        f->evaluateAtAbscissae(t, results, numberOfParameters, c);
+      }, f, context(), f->color(), false, 0.0f, 0.0f, false, sampleCache);
     }
 
     /* Draw tangent */
@@ -21,6 +21,11 @@ public:
   void setAreaHighlightColor(bool highlightColor) override {};
 private:
   CartesianFunctionStore * m_functionStore;
+  /* Samples of one function, kept across redraws and pans: the selected
+   * function, whose area is colored and which the cursor browses, or the first
+   * active function. A cache holds a screen width of samples, about 1.5 KB, so
+   * the other functions are not cached. */
+  mutable Shared::CurveSampleCache m_sampleCache;
   bool m_tangent;
 };
 
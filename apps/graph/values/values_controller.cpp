@@ -144,13 +144,16 @@ FunctionParameterController * ValuesController::functionParameterController() {
   return &m_functionParameterController;
 }
 
-double ValuesController::evaluationOfAbscissaAtColumn(double abscissa, int columnIndex) {
-  CartesianFunction * function = functionAtColumn(columnIndex);
-  TextFieldDelegateApp * myApp = (TextFieldDelegateApp *)app();
+void ValuesController::evaluationOfAbscissaeAtColumn(const double * abscissae, double * results, int numberOfAbscissae, int columnIndex) {
   if (isDerivativeColumn(columnIndex)) {
-    return function->approximateDerivative(abscissa, myApp->localContext());
+    CartesianFunction * function = functionAtColumn(columnIndex);
+    TextFieldDelegateApp * myApp = (TextFieldDelegateApp *)app();
+    for (int i = 0; i < numberOfAbscissae; i++) {
+      results[i] = function->approximateDerivative(abscissae[i], myApp->localContext());
+    }
+    return;
   }
-  return function->evaluateAtAbscissa(abscissa, myApp->localContext());
+  Shared::ValuesController::evaluationOfAbscissaeAtColumn(abscissae, results, numberOfAbscissae, columnIndex);
 }
 
 void ValuesController::updateNumberOfColumns() {
@@ -24,7 +24,7 @@ private:
   void configureDerivativeFunction();
   int maxNumberOfCells() override;
   int maxNumberOfFunctions() override;
-  double evaluationOfAbscissaAtColumn(double abscissa, int columnIndex) override;
+  void evaluationOfAbscissaeAtColumn(const double * abscissae, double * results, int numberOfAbscissae, int columnIndex) override;
   constexpr static int k_maxNumberOfCells = 50;
   constexpr static int k_maxNumberOfFunctions = 5;
   Shared::BufferFunctionTitleCell m_functionTitleCells[k_maxNumberOfFunctions];
@@ -1,6 +1,7 @@
 #include <quiz.h>
 #include <string.h>
 #include <assert.h>
+#include <poincare/global_context.h>
 #include "../model/model.h"
 #include "../regression_context.h"
 #include "../store.h"
@@ -93,3 +94,23 @@ QUIZ_CASE(logistic_regression) {
   double coefficients[] = {6, 1.5, 4.7};
   assert_regression_is(x, y, 4, Model::Type::Logistic, coefficients);
 }
+
+/* Predicting X from Y looks for the first intersection of the model with y on
+ * the range of the store, which goes through the compiled solver for the
+ * models which do not override levelSet. */
+QUIZ_CASE(quadratic_regression_x_value_for_y_value) {
+  double x[] = {-1.0, 0.0, 1.0, 2.0, 3.0, 5.0};
+  double y[] = {5.0, 1.0, -1.0, -1.0, 1.0, 11.0};
+  int series = 0;
+  Regression::Store store;
+  for (int i = 0; i < 6; i++) {
+    store.set(x[i], series, 0, i);
+    store.set(y[i], series, 1, i);
+  }
+  GlobalContext globalContext;
+  RegressionContext context(&store);
+  context.setParentContext(&globalContext);
+  store.setSeriesRegressionType(series, Model::Type::Quadratic);
+  // x^2-3x+1 = -1 for x = 1 and x = 2
+  quiz_assert(std::fabs(store.xValueForYValue(series, -1.0, &context) - 1.0) < 0.01);
+}
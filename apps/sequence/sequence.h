@@ -46,6 +46,17 @@ public:
   double evaluateAtAbscissa(double x, Poincare::Context * context) const override {
     return templatedApproximateAtAbscissa(x, static_cast<SequenceContext *>(context));
   }
+  // Terms are computed rank by rank, from the sequence context cache
+  void evaluateAtAbscissae(const float * x, float * results, int numberOfAbscissae, Poincare::Context * context) const override {
+    for (int i = 0; i < numberOfAbscissae; i++) {
+      results[i] = evaluateAtAbscissa(x[i], context);
+    }
+  }
+  void evaluateAtAbscissae(const double * x, double * results, int numberOfAbscissae, Poincare::Context * context) const override {
+    for (int i = 0; i < numberOfAbscissae; i++) {
+      results[i] = evaluateAtAbscissa(x[i], context);
+    }
+  }
   template<typename T> T approximateToNextRank(int n, SequenceContext * sqctx) const;
   double sumBetweenBounds(double start, double end, Poincare::Context * context) const override;
   void tidy() override;
@@ -0,0 +1,107 @@
+#include "curve_sample_cache.h"
+#include <cmath>
+#include <assert.h>
+
+namespace Shared {
+
+CurveSampleCache::CurveSampleCache() :
+  m_checksum(0),
+  m_step(NAN),
+  m_firstIndex(0),
+  m_numberOfSamples(0)
+{
+}
+
+void CurveSampleCache::reset() {
+  m_step = NAN;
+  m_firstIndex = 0;
+  m_numberOfSamples = 0;
+}
+
+void CurveSampleCache::setCurveChecksum(uint32_t checksum) {
+  if (checksum != m_checksum) {
+    m_checksum = checksum;
+    reset();
+  }
+}
+
+float CurveSampleCache::setStep(float step) {
+  /* The range width is slightly modified by the rounding errors of a pan:
+   * keep the cached step if it is close enough, the samples being sub-pixel
+   * apart. */
+  if (std::isnan(m_step) || std::fabs(step - m_step) > k_stepTolerance*std::fabs(step)) {
+    reset();
+    m_step = step;
+  }
+  return m_step;
+}
+
+void CurveSampleCache::update(int firstIndex, int numberOfSamples, EvaluateModelWithParameter evaluation, EvaluateModelWithParameters batchEvaluation, void * model, void * context) {
+  assert(numberOfSamples <= k_numberOfSamples);
+  int lastIndex = firstIndex + numberOfSamples;
+  int cachedLastIndex = m_firstIndex + m_numberOfSamples;
+  if (m_numberOfSamples == 0 || firstIndex > cachedLastIndex || lastIndex < m_firstIndex) {
+    // No overlap with the cached window
+    m_firstIndex = firstIndex;
+    m_numberOfSamples = 0;
+    cachedLastIndex = firstIndex;
+  }
+  if (lastIndex > cachedLastIndex) {
+    // Extend the window to the right, dropping its leftmost samples if needed
+    int newFirstIndex = lastIndex - k_numberOfSamples;
+    if (newFirstIndex < m_firstIndex) {
+      newFirstIndex = m_firstIndex;
+    }
+    evaluate(cachedLastIndex, lastIndex - cachedLastIndex, evaluation, batchEvaluation, model, context);
+    m_firstIndex = newFirstIndex;
+    m_numberOfSamples = lastIndex - newFirstIndex;
+    cachedLastIndex = lastIndex;
+  }
+  if (firstIndex < m_firstIndex) {
+    // Extend the window to the left, dropping its rightmost samples if needed
+    int newLastIndex = firstIndex + k_numberOfSamples;
+    if (newLastIndex > cachedLastIndex) {
+      newLastIndex = cachedLastIndex;
+    }
+    evaluate(firstIndex, m_firstIndex - firstIndex, evaluation, batchEvaluation, model, context);
+    m_firstIndex = firstIndex;
+    m_numberOfSamples = newLastIndex - firstIndex;
+  }
+  assert(m_firstIndex <= firstIndex && lastIndex <= m_firstIndex + m_numberOfSamples);
+}
+
+float CurveSampleCache::sample(int index) const {
+  assert(index >= m_firstIndex && index < m_firstIndex + m_numberOfSamples);
+  return m_samples[bufferIndex(index)];
+}
+
+void CurveSampleCache::evaluate(int firstIndex, int numberOfSamples, EvaluateModelWithParameter evaluation, EvaluateModelWithParameters batchEvaluation, void * model, void * context) {
+  float abscissae[k_batchSize];
+  float ordinates[k_batchSize];
+  int index = firstIndex;
+  int lastIndex = firstIndex + numberOfSamples;
+  while (index < lastIndex) {
+    int batchSize = lastIndex - index < k_batchSize ? lastIndex - index : k_batchSize;
+    for (int i = 0; i < batchSize; i++) {
+      abscissae[i] = (float)(index + i)*m_step;
+    }
+    if (batchEvaluation != nullptr) {
+      batchEvaluation(abscissae, ordinates, batchSize, model, context);
+    } else {
+      for (int i = 0; i < batchSize; i++) {
+        ordinates[i] = evaluation(abscissae[i], model, context);
+      }
+    }
+    for (int i = 0; i < batchSize; i++) {
+      m_samples[bufferIndex(index + i)] = ordinates[i];
+    }
+    index += batchSize;
+  }
+}
+
+int CurveSampleCache::bufferIndex(int index) {
+  int result = index % k_numberOfSamples;
+  return result < 0 ? result + k_numberOfSamples : result;
+}
+
+}
@@ -0,0 +1,50 @@
+#ifndef SHARED_CURVE_SAMPLE_CACHE_H
+#define SHARED_CURVE_SAMPLE_CACHE_H
+
+#include <stdint.h>
+
+namespace Shared {
+
+/* A CurveSampleCache keeps the evaluations of a curve at the abscissae
+ * k*step for a window of consecutive indices k. The abscissae only depend on
+ * the horizontal step, so redrawing an unchanged curve does not evaluate it
+ * again and panning only evaluates the newly exposed abscissae.
+ * The samples are stored in a ring buffer: sample k is at index k modulo
+ * k_numberOfSamples. */
+
+class CurveSampleCache {
+public:
+  typedef float (*EvaluateModelWithParameter)(float t, void * model, void * context);
+  typedef void (*EvaluateModelWithParameters)(const float * t, float * results, int numberOfParameters, void * model, void * context);
+  CurveSampleCache();
+  void reset();
+  // Clear the cache if the curve checksum changed
+  void setCurveChecksum(uint32_t checksum);
+  /* Clear the cache if step is too far from the cached step. Return the step
+   * to sample the curve with. */
+  float setStep(float step);
+  float step() const { return m_step; }
+  /* Evaluate the samples of indices [firstIndex, firstIndex+numberOfSamples)
+   * which are not in the cache yet. batchEvaluation may be null. */
+  void update(int firstIndex, int numberOfSamples, EvaluateModelWithParameter evaluation, EvaluateModelWithParameters batchEvaluation, void * model, void * context);
+  float sample(int index) const;
+  /* The abscissae k*step are exact as long as k is exactly represented as a
+   * float. */
+  constexpr static int k_maxIndex = 1 << 24;
+  // Enough for the width of the screen with the default sampling ratio
+  constexpr static int k_numberOfSamples = 368;
+private:
+  constexpr static float k_stepTolerance = 1E-5f;
+  constexpr static int k_batchSize = 32;
+  void evaluate(int firstIndex, int numberOfSamples, EvaluateModelWithParameter evaluation, EvaluateModelWithParameters batchEvaluation, void * model, void * context);
+  static int bufferIndex(int index);
+  uint32_t m_checksum;
+  float m_step;
+  int m_firstIndex;
+  int m_numberOfSamples;
+  float m_samples[k_numberOfSamples];
+};
+
+}
+
+#endif
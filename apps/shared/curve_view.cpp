@@ -1,4 +1,5 @@
 #include "curve_view.h"
+#include "stamp_strip.h"
 #include "../constant.h"
 #include <assert.h>
 #include <string.h>
@@ -296,7 +297,7 @@ void CurveView::drawAxes(KDContext * ctx, KDRect rect, Axis axis) const {
 
 constexpr KDCoordinate circleDiameter = 1;
 constexpr KDCoordinate stampSize = circleDiameter+1;
-const uint8_t stampMask[stampSize+1][stampSize+1] = {
+constexpr uint8_t stampMask[stampSize+1][stampSize+1] = {
   {0xFF, 0xE1, 0xFF},
   {0xE1, 0x00, 0xE1},
   {0xFF, 0xE1, 0xFF},
@@ -306,7 +307,7 @@ const uint8_t stampMask[stampSize+1][stampSize+1] = {
 
 constexpr KDCoordinate circleDiameter = 2;
 constexpr KDCoordinate stampSize = circleDiameter+1;
-const uint8_t stampMask[stampSize+1][stampSize+1] = {
+constexpr uint8_t stampMask[stampSize+1][stampSize+1] = {
   {0xFF, 0xE6, 0xE6, 0xFF},
   {0xE6, 0x33, 0x33, 0xE6},
   {0xE6, 0x33, 0x33, 0xE6},
@@ -317,7 +318,7 @@ const uint8_t stampMask[stampSize+1][stampSize+1] = {
 
 constexpr KDCoordinate circleDiameter = 3;
 constexpr KDCoordinate stampSize = circleDiameter+1;
-const uint8_t stampMask[stampSize+1][stampSize+1] = {
+constexpr uint8_t stampMask[stampSize+1][stampSize+1] = {
   {0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
   {0xFF, 0x7A, 0x0C, 0x7A, 0xFF},
   {0xFF, 0x0C, 0x00, 0x0C, 0xFF},
@@ -329,7 +330,7 @@ const uint8_t stampMask[stampSize+1][stampSize+1] = {
 
 constexpr KDCoordinate circleDiameter = 5;
 constexpr KDCoordinate stampSize = circleDiameter+1;
-const uint8_t stampMask[stampSize+1][stampSize+1] = {
+constexpr uint8_t stampMask[stampSize+1][stampSize+1] = {
   {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
   {0xFF, 0xE1, 0x45, 0x0C, 0x45, 0xE1, 0xFF},
   {0xFF, 0x45, 0x00, 0x00, 0x00, 0x45, 0xFF},
@@ -341,9 +342,50 @@ const uint8_t stampMask[stampSize+1][stampSize+1] = {
 
 #endif
 
+/* The stamp is shifted by a fraction of pixel to draw with anti-aliasing. The
+ * shifts are rounded to 1/k_subpixelPrecision of pixel so that the shifted
+ * masks can be generated at compile time: shiftedMasks.masks[sy*k_numberOfShifts+sx]
+ * is the stamp shifted by (sx, sy)/k_subpixelPrecision. */
+constexpr int k_subpixelPrecision = 8;
+constexpr int k_numberOfShifts = k_subpixelPrecision+1;
+
+constexpr uint8_t shiftedMaskValue(int sx, int sy, int i, int j) {
+  return (sx*(stampMask[i][j]*sy + stampMask[i+1][j]*(k_subpixelPrecision-sy))
+      + (k_subpixelPrecision-sx)*(stampMask[i][j+1]*sy + stampMask[i+1][j+1]*(k_subpixelPrecision-sy)))
+    / (k_subpixelPrecision*k_subpixelPrecision);
+}
+
+template<int... I> struct Indices {};
+template<int N, int... I> struct MakeIndices : MakeIndices<N-1, N-1, I...> {};
+template<int... I> struct MakeIndices<0, I...> { typedef Indices<I...> type; };
+
+struct StampMask {
+  uint8_t pixels[stampSize*stampSize];
+};
+
+struct ShiftedMasks {
+  StampMask masks[k_numberOfShifts*k_numberOfShifts];
+};
+
+template<int... Pixel>
+constexpr StampMask makeShiftedMask(int shift, Indices<Pixel...>) {
+  return StampMask{{shiftedMaskValue(shift%k_numberOfShifts, shift/k_numberOfShifts, Pixel/stampSize, Pixel%stampSize)...}};
+}
+
+template<int... Shift>
+constexpr ShiftedMasks makeShiftedMasks(Indices<Shift...>) {
+  return ShiftedMasks{{makeShiftedMask(Shift, MakeIndices<stampSize*stampSize>::type())...}};
+}
+
+constexpr static ShiftedMasks shiftedMasks = makeShiftedMasks(MakeIndices<k_numberOfShifts*k_numberOfShifts>::type());
+
+static_assert(shiftedMasks.masks[k_numberOfShifts*k_numberOfShifts-1].pixels[stampSize*stampSize-1] == stampMask[stampSize-1][stampSize-1], "Shifted masks are not generated correctly");
+
+static StampStrip sStampStrip;
+
 constexpr static int k_maxNumberOfIterations = 10;
 
-void CurveView::drawCurve(KDContext * ctx, KDRect rect, EvaluateModelWithParameter evaluation, void * model, void * context, KDColor color, bool colorUnderCurve, float colorLowerBound, float colorUpperBound, bool continuously) const {
+void CurveView::drawCurve(KDContext * ctx, KDRect rect, EvaluateModelWithParameter evaluation, EvaluateModelWithParameters batchEvaluation, void * model, void * context, KDColor color, bool colorUnderCurve, float colorLowerBound, float colorUpperBound, bool continuously, CurveSampleCache * sampleCache) const {
   float xMin = min(Axis::Horizontal);
   float xMax = max(Axis::Horizontal);
   float xStep = (xMax-xMin)/resolution();
@@ -353,37 +395,90 @@ void CurveView::drawCurve(KDContext * ctx, KDRect rect, EvaluateModelWithParamet
   float pixelColorLowerBound = std::round(floatToPixel(Axis::Horizontal, colorLowerBound));
   float pixelColorUpperBound = std::round(floatToPixel(Axis::Horizontal, colorUpperBound));
 
-  for (float x = rectMin; x < rectMax; x += xStep) {
-    /* When |rectMin| >> xStep, rectMin + xStep = rectMin. In that case, quit
-     * the infinite loop. */
-    if (x == x-xStep || x == x+xStep) {
-      return;
-    }
-    float y = evaluation(x, model, context);
-    if (std::isnan(y)|| std::isinf(y)) {
-      continue;
+  // Samples of indices [sampleIndex, lastSampleIndex) are read from the cache
+  int sampleIndex = 0;
+  int lastSampleIndex = 0;
+  if (sampleCache != nullptr) {
+    float cachedStep = sampleCache->setStep(xStep);
+    float firstIndex = std::ceil(rectMin/cachedStep);
+    float lastIndex = std::ceil(rectMax/cachedStep);
+    if (std::fabs(firstIndex) < CurveSampleCache::k_maxIndex && std::fabs(lastIndex) < CurveSampleCache::k_maxIndex && lastIndex - firstIndex <= CurveSampleCache::k_numberOfSamples) {
+      xStep = cachedStep;
+      sampleIndex = firstIndex;
+      lastSampleIndex = lastIndex;
+      sampleCache->update(sampleIndex, lastSampleIndex - sampleIndex, evaluation, batchEvaluation, model, context);
+    } else {
+      sampleCache = nullptr;
     }
-    float pxf = floatToPixel(Axis::Horizontal, x);
-    float pyf = floatToPixel(Axis::Vertical, y);
-    if (colorUnderCurve && pxf > pixelColorLowerBound && pxf < pixelColorUpperBound) {
-      KDRect colorRect((int)pxf, std::round(pyf), 1, std::round(floatToPixel(Axis::Vertical, 0.0f)) - std::round(pyf));
-      if (floatToPixel(Axis::Vertical, 0.0f) < std::round(pyf)) {
-        colorRect = KDRect((int)pxf, std::round(floatToPixel(Axis::Vertical, 0.0f)), 1, std::round(pyf) - std::round(floatToPixel(Axis::Vertical, 0.0f)));
+  }
+
+  float abscissae[k_curveBatchSize];
+  float ordinates[k_curveBatchSize];
+  float previousX = NAN;
+  float previousY = NAN;
+  float x = rectMin;
+  bool lastBatch = false;
+  while (!lastBatch && (sampleCache != nullptr ? sampleIndex < lastSampleIndex : x < rectMax)) {
+    int numberOfAbscissae = 0;
+    if (sampleCache != nullptr) {
+      while (numberOfAbscissae < k_curveBatchSize && sampleIndex < lastSampleIndex) {
+        abscissae[numberOfAbscissae] = (float)sampleIndex*xStep;
+        ordinates[numberOfAbscissae++] = sampleCache->sample(sampleIndex++);
       }
-      ctx->fillRect(colorRect, color);
-    }
-    stampAtLocation(ctx, rect, pxf, pyf, color);
-    if (x <= rectMin || std::isnan(evaluation(x-xStep, model, context))) {
-      continue;
-    }
-    if (continuously) {
-      float puf = floatToPixel(Axis::Horizontal, x - xStep);
-      float pvf = floatToPixel(Axis::Vertical, evaluation(x-xStep, model, context));
-      straightJoinDots(ctx, rect, puf, pvf, pxf, pyf, color);
     } else {
-      jointDots(ctx, rect, evaluation, model, context, x - xStep, evaluation(x-xStep, model, context), x, y, color, k_maxNumberOfIterations);
+      while (numberOfAbscissae < k_curveBatchSize && x < rectMax) {
+        /* When |rectMin| >> xStep, rectMin + xStep = rectMin. In that case,
+         * quit the infinite loop. */
+        if (x == x-xStep || x == x+xStep) {
+          lastBatch = true;
+          break;
+        }
+        abscissae[numberOfAbscissae++] = x;
+        x += xStep;
+      }
+      if (batchEvaluation != nullptr) {
+        batchEvaluation(abscissae, ordinates, numberOfAbscissae, model, context);
+      } else {
+        for (int i = 0; i < numberOfAbscissae; i++) {
+          ordinates[i] = evaluation(abscissae[i], model, context);
+        }
+      }
+    }
+    for (int i = 0; i < numberOfAbscissae; i++) {
+      float u = previousX;
+      float v = previousY;
+      previousX = abscissae[i];
+      previousY = ordinates[i];
+      float y = ordinates[i];
+      if (std::isnan(y)|| std::isinf(y)) {
+        continue;
+      }
+      float pxf = floatToPixel(Axis::Horizontal, abscissae[i]);
+      float pyf = floatToPixel(Axis::Vertical, y);
+      if (colorUnderCurve && pxf > pixelColorLowerBound && pxf < pixelColorUpperBound) {
+        KDRect colorRect((int)pxf, std::round(pyf), 1, std::round(floatToPixel(Axis::Vertical, 0.0f)) - std::round(pyf));
+        if (floatToPixel(Axis::Vertical, 0.0f) < std::round(pyf)) {
+          colorRect = KDRect((int)pxf, std::round(floatToPixel(Axis::Vertical, 0.0f)), 1, std::round(pyf) - std::round(floatToPixel(Axis::Vertical, 0.0f)));
+        }
+        // The strip would overwrite the colored rect when pushed back
+        sStampStrip.flush();
+        ctx->fillRect(colorRect, color);
+      }
+      stampAtLocation(ctx, rect, pxf, pyf, color);
+      // Join the dot to the previous sample, if any
+      if (std::isnan(u) || std::isnan(v)) {
+        continue;
+      }
+      if (continuously) {
+        float puf = floatToPixel(Axis::Horizontal, u);
+        float pvf = floatToPixel(Axis::Vertical, v);
+        straightJoinDots(ctx, rect, puf, pvf, pxf, pyf, color);
+      } else {
+        jointDots(ctx, rect, evaluation, model, context, u, v, abscissae[i], y, color, k_maxNumberOfIterations);
+      }
     }
   }
+  sStampStrip.flush();
 }
 
 void CurveView::drawHistogram(KDContext * ctx, KDRect rect, EvaluateModelWithParameter evaluation, void * model, void * context, float firstBarAbscissa, float barWidth,
@@ -501,20 +596,9 @@ void CurveView::stampAtLocation(KDContext * ctx, KDRect rect, float pxf, float p
   if (!rect.intersects(stampRect)) {
     return;
   }
-  uint8_t shiftedMask[stampSize][stampSize];
-  KDColor workingBuffer[stampSize*stampSize];
-  float dx = pxf - std::floor(pxf);
-  float dy = pyf - std::floor(pyf);
-  /* TODO: this could be optimized by precomputing 10 or 100 shifted masks. The
-   * dx and dy would be rounded to one tenth or one hundredth to choose the
-   * right shifted mask. */
-  for (int i=0; i<stampSize; i++) {
-    for (int j=0; j<stampSize; j++) {
-      shiftedMask[i][j] = dx * (stampMask[i][j]*dy+stampMask[i+1][j]*(1.0f-dy))
-        + (1.0f-dx) * (stampMask[i][j+1]*dy + stampMask[i+1][j+1]*(1.0f-dy));
-    }
-  }
-  ctx->blendRectWithMask(stampRect, color, (const uint8_t *)shiftedMask, workingBuffer);
+  int sx = std::round((pxf - std::floor(pxf))*k_subpixelPrecision);
+  int sy = std::round((pyf - std::floor(pyf))*k_subpixelPrecision);
+  sStampStrip.blendStamp(ctx, rect, stampRect, shiftedMasks.masks[sy*k_numberOfShifts+sx].pixels, color);
 }
 
 void CurveView::layoutSubviews() {
@@ -6,6 +6,7 @@
 #include <cmath>
 #include "curve_view_range.h"
 #include "curve_view_cursor.h"
+#include "curve_sample_cache.h"
 #include "banner_view.h"
 
 namespace Shared {
@@ -13,6 +14,7 @@ namespace Shared {
 class CurveView : public View {
 public:
   typedef float (*EvaluateModelWithParameter)(float t, void * model, void * context);
+  typedef void (*EvaluateModelWithParameters)(const float * t, float * results, int numberOfParameters, void * model, void * context);
   enum class Axis {
     Horizontal = 0,
     Vertical = 1
@@ -45,6 +47,7 @@ protected:
   constexpr static int k_maxNumberOfXLabels = CurveViewRange::k_maxNumberOfXGridUnits;
   constexpr static int k_maxNumberOfYLabels = CurveViewRange::k_maxNumberOfYGridUnits;
   constexpr static int k_externRectMargin = 2;
+  constexpr static int k_curveBatchSize = 32;
   float pixelToFloat(Axis axis, KDCoordinate p) const;
   float floatToPixel(Axis axis, float f) const;
   void drawLine(KDContext * ctx, KDRect rect, Axis axis,
@@ -56,7 +59,15 @@ protected:
   void drawGridLines(KDContext * ctx, KDRect rect, Axis axis, float step, KDColor color) const;
   void drawGrid(KDContext * ctx, KDRect rect) const;
   void drawAxes(KDContext * ctx, KDRect rect, Axis axis) const;
-  void drawCurve(KDContext * ctx, KDRect rect, EvaluateModelWithParameter evaluation, void * model, void * context, KDColor color, bool colorUnderCurve = false, float colorLowerBound = 0.0f, float colorUpperBound = 0.0f, bool continuously = false) const;
+  void drawCurve(KDContext * ctx, KDRect rect, EvaluateModelWithParameter evaluation, void * model, void * context, KDColor color, bool colorUnderCurve = false, float colorLowerBound = 0.0f, float colorUpperBound = 0.0f, bool continuously = false) const {
+    drawCurve(ctx, rect, evaluation, nullptr, model, context, color, colorUnderCurve, colorLowerBound, colorUpperBound, continuously);
+  }
+  /* The curve is sampled by batches of k_curveBatchSize abscissae. If
+   * batchEvaluation is not null, it is used to evaluate each batch at once
+   * instead of calling evaluation on each abscissa. If sampleCache is not
+   * null, the curve is sampled at multiples of the step and the samples are
+   * kept in the cache across redraws. */
+  void drawCurve(KDContext * ctx, KDRect rect, EvaluateModelWithParameter evaluation, EvaluateModelWithParameters batchEvaluation, void * model, void * context, KDColor color, bool colorUnderCurve = false, float colorLowerBound = 0.0f, float colorUpperBound = 0.0f, bool continuously = false, CurveSampleCache * sampleCache = nullptr) const;
   void drawHistogram(KDContext * ctx, KDRect rect, EvaluateModelWithParameter evaluation, void * model, void * context, float firstBarAbscissa, float barWidth,
     bool fillBar, KDColor defaultColor, KDColor highlightColor,  float highlightLowerBound = INFINITY, float highlightUpperBound = -INFINITY) const;
   void computeLabels(Axis axis);
@@ -79,7 +90,8 @@ private:
   void straightJoinDots(KDContext * ctx, KDRect rect, float pxf, float pyf, float puf, float pvf, KDColor color) const;
   /* Stamp centered around (pxf, pyf). If pxf and pyf are not round number, the
    * function shifts the stamp (by blending adjacent pixel colors) to draw with
-   * anti alising. */
+   * anti alising. The stamp is blended in an off-screen strip which is pushed
+   * to ctx at the end of drawCurve. */
   void stampAtLocation(KDContext * ctx, KDRect rect, float pxf, float pyf, KDColor color) const;
   void layoutSubviews() override;
   KDRect cursorFrame();
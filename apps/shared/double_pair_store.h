@@ -38,7 +38,7 @@ public:
   virtual void deletePairOfSeriesAtIndex(int series, int j);
   virtual void deleteAllPairsOfSeries(int series);
   void deleteAllPairs();
-  void resetColumn(int series, int i);
+  virtual void resetColumn(int series, int i);
 
   // Series
   virtual bool isEmpty() const;
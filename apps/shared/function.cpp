@@ -11,7 +11,9 @@ Function::Function(const char * name, KDColor color) :
   ExpressionModel(),
   m_name(name),
   m_color(color),
-  m_active(true)
+  m_active(true),
+  m_floatCompiledExpression(),
+  m_doubleCompiledExpression()
 {
 }
 
@@ -39,12 +41,53 @@ void Function::setActive(bool active) {
   m_active = active;
 }
 
+void Function::setContent(const char * c) {
+  ExpressionModel::setContent(c);
+  m_floatCompiledExpression = CompiledExpression<float>();
+  m_doubleCompiledExpression = CompiledExpression<double>();
+}
+
+void Function::tidy() {
+  ExpressionModel::tidy();
+  m_floatCompiledExpression = CompiledExpression<float>();
+  m_doubleCompiledExpression = CompiledExpression<double>();
+}
+
+template<>
+CompiledExpression<float> & Function::compiledExpressionCache<float>() const {
+  return m_floatCompiledExpression;
+}
+
+template<>
+CompiledExpression<double> & Function::compiledExpressionCache<double>() const {
+  return m_doubleCompiledExpression;
+}
+
+template<typename T>
+const CompiledExpression<T> & Function::compiledExpression(Poincare::Context * context) const {
+  CompiledExpression<T> & compiled = compiledExpressionCache<T>();
+  Preferences::AngleUnit angleUnit = Preferences::sharedPreferences()->angleUnit();
+  if (compiled.isUninitialized() || compiled.angleUnit() != angleUnit) {
+    compiled = CompiledExpression<T>(expression(context), symbol(), *context, angleUnit);
+  }
+  return compiled;
+}
+
 template<typename T>
 T Function::templatedApproximateAtAbscissa(T x, Poincare::Context * context) const {
-  return expression(context).approximateWithValueForSymbol(symbol(), x, *context, Preferences::sharedPreferences()->angleUnit());
+  return compiledExpression<T>(context).approximateWithValueForSymbol(x, *context);
+}
+
+template<typename T>
+void Function::templatedApproximateAtAbscissae(const T * x, T * results, int numberOfAbscissae, Poincare::Context * context) const {
+  compiledExpression<T>(context).approximateWithValuesForSymbol(x, results, numberOfAbscissae, *context);
 }
 
 }
 
+template const Poincare::CompiledExpression<float> & Shared::Function::compiledExpression<float>(Poincare::Context*) const;
+template const Poincare::CompiledExpression<double> & Shared::Function::compiledExpression<double>(Poincare::Context*) const;
 template float Shared::Function::templatedApproximateAtAbscissa<float>(float, Poincare::Context*) const;
 template double Shared::Function::templatedApproximateAtAbscissa<double>(double, Poincare::Context*) const;
+template void Shared::Function::templatedApproximateAtAbscissae<float>(const float *, float *, int, Poincare::Context*) const;
+template void Shared::Function::templatedApproximateAtAbscissae<double>(const double *, double *, int, Poincare::Context*) const;
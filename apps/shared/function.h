@@ -20,15 +20,33 @@ public:
   virtual double evaluateAtAbscissa(double x, Poincare::Context * context) const {
     return templatedApproximateAtAbscissa(x, context);
   }
+  /* Fill results with the evaluations at all the given abscissae, which is
+   * much faster than evaluating them one by one. */
+  virtual void evaluateAtAbscissae(const float * x, float * results, int numberOfAbscissae, Poincare::Context * context) const {
+    templatedApproximateAtAbscissae(x, results, numberOfAbscissae, context);
+  }
+  virtual void evaluateAtAbscissae(const double * x, double * results, int numberOfAbscissae, Poincare::Context * context) const {
+    templatedApproximateAtAbscissae(x, results, numberOfAbscissae, context);
+  }
   virtual double sumBetweenBounds(double start, double end, Poincare::Context * context) const = 0;
+  void setContent(const char * c) override;
+  void tidy() override;
+protected:
+  /* The compiled expressions are built lazily from expression(context) and
+   * dropped with it, in setContent and tidy. */
+  template<typename T> const Poincare::CompiledExpression<T> & compiledExpression(Poincare::Context * context) const;
 private:
   constexpr static size_t k_dataLengthInBytes = (TextField::maxBufferSize()+2)*sizeof(char)+2;
   static_assert((k_dataLengthInBytes & 0x3) == 0, "The function data size is not a multiple of 4 bytes (cannot compute crc)"); // Assert that dataLengthInBytes is a multiple of 4
   template<typename T> T templatedApproximateAtAbscissa(T x, Poincare::Context * context) const;
+  template<typename T> void templatedApproximateAtAbscissae(const T * x, T * results, int numberOfAbscissae, Poincare::Context * context) const;
+  template<typename T> Poincare::CompiledExpression<T> & compiledExpressionCache() const;
   virtual char symbol() const = 0;
   const char * m_name;
   KDColor m_color;
   bool m_active;
+  mutable Poincare::CompiledExpression<float> m_floatCompiledExpression;
+  mutable Poincare::CompiledExpression<double> m_doubleCompiledExpression;
 };
 
 }
@@ -0,0 +1,54 @@
+#include "stamp_strip.h"
+#include <assert.h>
+
+namespace Shared {
+
+void StampStrip::blendStamp(KDContext * ctx, KDRect rect, KDRect stampRect, const uint8_t * mask, KDColor color) {
+  KDRect visibleStampRect = stampRect.intersectedWith(rect);
+  if (visibleStampRect.isEmpty()) {
+    return;
+  }
+  if (ctx != m_context || !(rect == m_rect) || visibleStampRect.left() < m_left || visibleStampRect.right() >= m_left + m_width) {
+    flush();
+    assert(rect.height() <= Ion::Display::Height);
+    m_context = ctx;
+    m_rect = rect;
+    m_left = visibleStampRect.left();
+    m_width = rect.right() + 1 - m_left < k_stripWidth ? rect.right() + 1 - m_left : k_stripWidth;
+  }
+  if (m_top == m_bottom) {
+    pullRows(visibleStampRect.top(), visibleStampRect.bottom() + 1);
+    m_top = visibleStampRect.top();
+    m_bottom = visibleStampRect.bottom() + 1;
+  }
+  if (visibleStampRect.top() < m_top) {
+    pullRows(visibleStampRect.top(), m_top);
+    m_top = visibleStampRect.top();
+  }
+  if (visibleStampRect.bottom() >= m_bottom) {
+    pullRows(m_bottom, visibleStampRect.bottom() + 1);
+    m_bottom = visibleStampRect.bottom() + 1;
+  }
+  for (KDCoordinate y = visibleStampRect.top(); y <= visibleStampRect.bottom(); y++) {
+    KDColor * row = m_pixels + (y - m_rect.top())*m_width;
+    const uint8_t * maskRow = mask + (y - stampRect.top())*stampRect.width();
+    for (KDCoordinate x = visibleStampRect.left(); x <= visibleStampRect.right(); x++) {
+      row[x - m_left] = KDColor::blend(row[x - m_left], color, maskRow[x - stampRect.left()]);
+    }
+  }
+}
+
+void StampStrip::flush() {
+  if (m_top < m_bottom) {
+    m_context->fillRectWithPixels(KDRect(m_left, m_top, m_width, m_bottom - m_top), m_pixels + (m_top - m_rect.top())*m_width, nullptr);
+  }
+  m_context = nullptr;
+  m_top = 0;
+  m_bottom = 0;
+}
+
+void StampStrip::pullRows(KDCoordinate top, KDCoordinate bottom) {
+  m_context->getPixels(KDRect(m_left, top, m_width, bottom - top), m_pixels + (top - m_rect.top())*m_width);
+}
+
+}
@@ -0,0 +1,39 @@
+#ifndef SHARED_STAMP_STRIP_H
+#define SHARED_STAMP_STRIP_H
+
+#include <kandinsky.h>
+#include <ion/display.h>
+
+namespace Shared {
+
+/* The stamps of a curve are not blended on the screen one by one: that would
+ * pull each of them from the screen. They are blended into a strip of at most
+ * k_stripWidth columns of the rect being redrawn. The rows of the strip are
+ * pulled from the screen as the stamps reach them, and pushed back when a
+ * stamp falls out of the strip columns or when the curve is drawn.
+ * The strip is as high as the screen: it takes 3840 bytes of RAM. */
+
+class StampStrip {
+public:
+  constexpr static KDCoordinate k_stripWidth = 8;
+  StampStrip() : m_context(nullptr), m_rect(KDRectZero), m_left(0), m_width(0), m_top(0), m_bottom(0) {}
+  /* Blend color into the part of stampRect inside rect, with the mask of
+   * stampRect, as KDContext::blendRectWithMask does. */
+  void blendStamp(KDContext * ctx, KDRect rect, KDRect stampRect, const uint8_t * mask, KDColor color);
+  // Push the strip back to its context
+  void flush();
+private:
+  void pullRows(KDCoordinate top, KDCoordinate bottom);
+  KDContext * m_context;
+  KDRect m_rect;
+  // The strip columns are [m_left, m_left+m_width) and its pulled rows are [m_top, m_bottom)
+  KDCoordinate m_left;
+  KDCoordinate m_width;
+  KDCoordinate m_top;
+  KDCoordinate m_bottom;
+  KDColor m_pixels[k_stripWidth*Ion::Display::Height];
+};
+
+}
+
+#endif
@@ -0,0 +1,54 @@
+#include <quiz.h>
+#include <assert.h>
+#include <cmath>
+#include "../curve_sample_cache.h"
+
+namespace Shared {
+
+static float square(float t, void * model, void * context) {
+  int * numberOfEvaluations = static_cast<int *>(context);
+  (*numberOfEvaluations)++;
+  return t*t;
+}
+
+void assert_cache_samples_square(CurveSampleCache * cache, int firstIndex, int numberOfSamples, int * numberOfEvaluations, int expectedNumberOfEvaluations) {
+  *numberOfEvaluations = 0;
+  cache->update(firstIndex, numberOfSamples, square, nullptr, nullptr, numberOfEvaluations);
+  quiz_assert(*numberOfEvaluations == expectedNumberOfEvaluations);
+  for (int k = firstIndex; k < firstIndex + numberOfSamples; k++) {
+    float x = (float)k*cache->step();
+    quiz_assert(cache->sample(k) == x*x);
+  }
+}
+
+QUIZ_CASE(curve_sample_cache) {
+  CurveSampleCache cache;
+  int numberOfEvaluations = 0;
+  const int n = CurveSampleCache::k_numberOfSamples;
+  cache.setCurveChecksum(1);
+  quiz_assert(cache.setStep(0.1f) == 0.1f);
+  assert_cache_samples_square(&cache, -100, 300, &numberOfEvaluations, 300);
+  // Redraw: no evaluation
+  assert_cache_samples_square(&cache, -100, 300, &numberOfEvaluations, 0);
+  assert_cache_samples_square(&cache, -50, 20, &numberOfEvaluations, 0);
+  // Close step: the cache is kept
+  quiz_assert(cache.setStep(0.1f*(1.0f+1E-6f)) == 0.1f);
+  assert_cache_samples_square(&cache, -100, 300, &numberOfEvaluations, 0);
+  // Pan to the right and to the left: only new samples are evaluated
+  assert_cache_samples_square(&cache, -60, 300, &numberOfEvaluations, 40);
+  assert_cache_samples_square(&cache, 240-n, n, &numberOfEvaluations, n-340);
+  assert_cache_samples_square(&cache, -200, 300, &numberOfEvaluations, (240-n)+200);
+  // Extending a full window drops the samples on the other side
+  assert_cache_samples_square(&cache, -200+n, 10, &numberOfEvaluations, 10);
+  assert_cache_samples_square(&cache, -200, 10, &numberOfEvaluations, 10);
+  // Disjoint window
+  assert_cache_samples_square(&cache, 10000, 300, &numberOfEvaluations, 300);
+  // Other step or curve: the cache is cleared
+  cache.setStep(0.2f);
+  assert_cache_samples_square(&cache, 10000, 300, &numberOfEvaluations, 300);
+  cache.setCurveChecksum(2);
+  cache.setStep(0.2f);
+  assert_cache_samples_square(&cache, 10000, 300, &numberOfEvaluations, 300);
+}
+
+}
@@ -0,0 +1,57 @@
+#include <quiz.h>
+#include <assert.h>
+#include <cmath>
+#include "../stamp_strip.h"
+
+namespace Shared {
+
+constexpr static KDCoordinate k_width = 40;
+constexpr static KDCoordinate k_height = 30;
+constexpr static KDCoordinate k_stampSize = 3;
+constexpr static uint8_t k_mask[k_stampSize*k_stampSize] = {
+  0xFF, 0x80, 0xE0,
+  0x40, 0x00, 0x60,
+  0xF0, 0x20, 0xFF
+};
+
+static void fillBackground(KDColor * pixels) {
+  for (int i = 0; i < k_width*k_height; i++) {
+    pixels[i] = KDColor::RGB24(0x10000*(i%k_width)*6 + 0x100*(i/k_width)*8 + 0x40);
+  }
+}
+
+// The stamps of a curve which goes back and forth, out of the rect and over itself
+static KDRect stampRect(int i) {
+  KDCoordinate x = i < 45 ? i - 3 : 90 - i;
+  KDCoordinate y = 15 + 17*std::sin(0.2f*i);
+  return KDRect(x, y, k_stampSize, k_stampSize);
+}
+
+static void assert_strip_blends_as_context(KDRect rect) {
+  static KDColor pixels[k_width*k_height];
+  static KDColor referencePixels[k_width*k_height];
+  fillBackground(pixels);
+  fillBackground(referencePixels);
+  KDFrameBuffer frameBuffer(pixels, KDSize(k_width, k_height));
+  KDFrameBufferContext context(&frameBuffer);
+  KDFrameBuffer referenceFrameBuffer(referencePixels, KDSize(k_width, k_height));
+  KDFrameBufferContext referenceContext(&referenceFrameBuffer);
+  referenceContext.setClippingRect(rect);
+  StampStrip strip;
+  KDColor workingBuffer[k_stampSize*k_stampSize];
+  for (int i = 0; i < 90; i++) {
+    strip.blendStamp(&context, rect, stampRect(i), k_mask, KDColorRed);
+    referenceContext.blendRectWithMask(stampRect(i), KDColorRed, k_mask, workingBuffer);
+  }
+  strip.flush();
+  for (int i = 0; i < k_width*k_height; i++) {
+    quiz_assert(pixels[i] == referencePixels[i]);
+  }
+}
+
+QUIZ_CASE(stamp_strip_blends_as_context) {
+  assert_strip_blends_as_context(KDRect(0, 0, k_width, k_height));
+  assert_strip_blends_as_context(KDRect(5, 7, 21, 13));
+}
+
+}
@@ -15,6 +15,8 @@ ValuesController::ValuesController(Responder * parentResponder, ButtonRowControl
   m_interval(interval),
   m_numberOfColumns(0),
   m_numberOfColumnsNeedUpdate(true),
+  m_valuesCache{},
+  m_nextCachedColumn(0),
   m_selectableTableView(this),
   m_abscissaTitleCell(),
   m_abscissaCells{},
@@ -153,8 +155,7 @@ void ValuesController::willDisplayCellAtLocation(HighlightCell * cell, int i, in
     }
     // The cell is a value cell
     EvenOddBufferTextCell * myValueCell = (EvenOddBufferTextCell *)cell;
-    double x = m_interval->element(j-1);
-    PoincareHelpers::ConvertFloatToText<double>(evaluationOfAbscissaAtColumn(x, i), buffer, PrintFloat::bufferSizeForFloatsWithPrecision(Constant::LargeNumberOfSignificantDigits), Constant::LargeNumberOfSignificantDigits);
+    PoincareHelpers::ConvertFloatToText<double>(evaluationOfAbscissaAtLocation(i, j), buffer, PrintFloat::bufferSizeForFloatsWithPrecision(Constant::LargeNumberOfSignificantDigits), Constant::LargeNumberOfSignificantDigits);
   myValueCell->setText(buffer);
   }
 }
@@ -243,6 +244,7 @@ Responder * ValuesController::defaultController() {
 }
 
 void ValuesController::viewWillAppear() {
+  resetValuesCache();
   EditableCellTableViewController::viewWillAppear();
   header()->setSelectedButton(-1);
 }
@@ -308,10 +310,40 @@ int ValuesController::maxNumberOfElements() const {
   return Interval::k_maxNumberOfElements;
 }
 
-double ValuesController::evaluationOfAbscissaAtColumn(double abscissa, int columnIndex) {
+double ValuesController::evaluationOfAbscissaAtLocation(int columnIndex, int rowIndex) {
+  double x = m_interval->element(rowIndex-1);
+  for (int k = 0; k < k_numberOfCachedColumns; k++) {
+    CachedColumn * c = &m_valuesCache[k];
+    int index = rowIndex - c->firstRowIndex;
+    if (c->columnIndex == columnIndex && index >= 0 && index < c->numberOfRows && c->abscissae[index] == x) {
+      return c->values[index];
+    }
+  }
+  CachedColumn * c = &m_valuesCache[m_nextCachedColumn];
+  m_nextCachedColumn = (m_nextCachedColumn + 1) % k_numberOfCachedColumns;
+  c->columnIndex = columnIndex;
+  c->firstRowIndex = rowIndex;
+  c->numberOfRows = m_interval->numberOfElements() - (rowIndex-1);
+  if (c->numberOfRows > k_maxNumberOfAbscissaCells) {
+    c->numberOfRows = k_maxNumberOfAbscissaCells;
+  }
+  for (int index = 0; index < c->numberOfRows; index++) {
+    c->abscissae[index] = m_interval->element(rowIndex-1+index);
+  }
+  evaluationOfAbscissaeAtColumn(c->abscissae, c->values, c->numberOfRows, columnIndex);
+  return c->values[0];
+}
+
+void ValuesController::evaluationOfAbscissaeAtColumn(const double * abscissae, double * results, int numberOfAbscissae, int columnIndex) {
   Function * function = functionAtColumn(columnIndex);
   TextFieldDelegateApp * myApp = (TextFieldDelegateApp *)app();
-  return function->evaluateAtAbscissa(abscissa, myApp->localContext());
+  function->evaluateAtAbscissae(abscissae, results, numberOfAbscissae, myApp->localContext());
+}
+
+void ValuesController::resetValuesCache() {
+  for (int k = 0; k < k_numberOfCachedColumns; k++) {
+    m_valuesCache[k].numberOfRows = 0;
+  }
 }
 
 void ValuesController::updateNumberOfColumns() {
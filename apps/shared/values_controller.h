@@ -46,6 +46,7 @@ protected:
   StackViewController * stackController() const;
   bool setDataAtLocation(double floatBody, int columnIndex, int rowIndex) override;
   virtual void updateNumberOfColumns();
+  virtual void evaluationOfAbscissaeAtColumn(const double * abscissae, double * results, int numberOfAbscissae, int columnIndex);
   Interval * m_interval;
   int m_numberOfColumns;
   bool m_numberOfColumnsNeedUpdate;
@@ -59,8 +60,23 @@ private:
   double dataAtLocation(int columnIndex, int rowIndex) override;
   int numberOfElements() override;
   int maxNumberOfElements() const override;
-  virtual double evaluationOfAbscissaAtColumn(double abscissa, int columnIndex);
+  /* The ordinates of a column are computed by batches of
+   * k_maxNumberOfAbscissaCells rows and kept in a small cache, as the table
+   * view displays its cells row by row. The cache is checked against the
+   * abscissae and cleared whenever the view appears. */
+  double evaluationOfAbscissaAtLocation(int columnIndex, int rowIndex);
+  void resetValuesCache();
   constexpr static int k_maxNumberOfAbscissaCells = 10;
+  constexpr static int k_numberOfCachedColumns = 4;
+  struct CachedColumn {
+    int columnIndex;
+    int firstRowIndex;
+    int numberOfRows;
+    double abscissae[k_maxNumberOfAbscissaCells];
+    double values[k_maxNumberOfAbscissaCells];
+  };
+  CachedColumn m_valuesCache[k_numberOfCachedColumns];
+  int m_nextCachedColumn;
   virtual int maxNumberOfCells() = 0;
   virtual int maxNumberOfFunctions() = 0;
   SelectableTableView m_selectableTableView;
@@ -11,7 +11,8 @@ EquationStore::EquationStore() :
   m_type(Type::LinearSystem),
   m_numberOfSolutions(0),
   m_exactSolutionExactLayouts{},
-  m_exactSolutionApproximateLayouts{}
+  m_exactSolutionApproximateLayouts{},
+  m_haveMoreApproximationSolutions(false)
 {
 }
 
@@ -60,33 +61,24 @@ double EquationStore::approximateSolutionAtIndex(int i) {
   return m_approximateSolutions[i];
 }
 
-bool EquationStore::haveMoreApproximationSolutions(Context * context) {
-  if (m_numberOfSolutions < k_maxNumberOfEquations) {
-    return false;
-  }
-  double step = (m_intervalApproximateSolutions[1]-m_intervalApproximateSolutions[0])*k_precision;
-  return !std::isnan(definedModelAtIndex(0)->standardForm(context).nextRoot(m_variables[0], m_approximateSolutions[m_numberOfSolutions-1], step, m_intervalApproximateSolutions[1], *context, Preferences::sharedPreferences()->angleUnit()));
-}
-
 void EquationStore::approximateSolve(Poincare::Context * context) {
   assert(m_variables[0] != 0 && m_variables[1] == 0);
   assert(m_type == Type::Monovariable);
-  m_numberOfSolutions = 0;
-  double start = m_intervalApproximateSolutions[0];
   double step = (m_intervalApproximateSolutions[1]-m_intervalApproximateSolutions[0])*k_precision;
-  for (int i = 0; i < k_maxNumberOfApproximateSolutions; i++) {
-    m_approximateSolutions[i] = definedModelAtIndex(0)->standardForm(context).nextRoot(m_variables[0], start, step, m_intervalApproximateSolutions[1], *context, Preferences::sharedPreferences()->angleUnit());
-    if (std::isnan(m_approximateSolutions[i])) {
-      break;
-    } else {
-      start = m_approximateSolutions[i];
-      m_numberOfSolutions++;
-    }
+  /* Look for one more solution than displayed to know if there are more
+   * solutions in the interval. */
+  double solutions[k_maxNumberOfApproximateSolutions+1];
+  int numberOfSolutions = definedModelAtIndex(0)->standardForm(context).nextRoots(m_variables[0], m_intervalApproximateSolutions[0], step, m_intervalApproximateSolutions[1], solutions, k_maxNumberOfApproximateSolutions+1, *context, Preferences::sharedPreferences()->angleUnit());
+  m_haveMoreApproximationSolutions = numberOfSolutions > k_maxNumberOfApproximateSolutions;
+  m_numberOfSolutions = m_haveMoreApproximationSolutions ? k_maxNumberOfApproximateSolutions : numberOfSolutions;
+  for (int i = 0; i < m_numberOfSolutions; i++) {
+    m_approximateSolutions[i] = solutions[i];
   }
 }
 
 EquationStore::Error EquationStore::exactSolve(Poincare::Context * context) {
   tidySolution();
+  m_haveMoreApproximationSolutions = false;
 
   /* 0- Get unknown variables */
   m_variables[0] = 0;
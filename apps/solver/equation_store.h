@@ -64,7 +64,7 @@ public:
   void setIntervalBound(int index, double value);
   double approximateSolutionAtIndex(int i);
   void approximateSolve(Poincare::Context * context);
-  bool haveMoreApproximationSolutions(Poincare::Context * context);
+  bool haveMoreApproximationSolutions() const { return m_haveMoreApproximationSolutions; }
 
   void tidy() override;
   static constexpr int k_maxNumberOfExactSolutions = Poincare::Expression::k_maxNumberOfVariables > Poincare::Expression::k_maxPolynomialDegree + 1? Poincare::Expression::k_maxNumberOfVariables : Poincare::Expression::k_maxPolynomialDegree + 1;
@@ -92,6 +92,7 @@ private:
   bool m_exactSolutionEquality[k_maxNumberOfExactSolutions];
   double m_intervalApproximateSolutions[2];
   double m_approximateSolutions[k_maxNumberOfApproximateSolutions];
+  bool m_haveMoreApproximationSolutions;
 };
 
 }
@@ -94,8 +94,7 @@ View * SolutionsController::view() {
 
 void SolutionsController::viewWillAppear() {
   ViewController::viewWillAppear();
-  App * solverApp = static_cast<App *>(app());
-  m_contentView.setWarningMoreSolutions(m_equationStore->haveMoreApproximationSolutions(solverApp->localContext()));
+  m_contentView.setWarningMoreSolutions(m_equationStore->haveMoreApproximationSolutions());
   m_contentView.selectableTableView()->reloadData();
   if (selectedRow() < 0) {
     selectCellAtLocation(0, 0);
@@ -64,7 +64,7 @@ void assert_equation_approximate_solve_to(const char * equations, double xMin, d
   for (int i = 0; i < numberOfSolutions; i++) {
     quiz_assert(std::fabs(equationStore.approximateSolutionAtIndex(i) - solutions[i]) < 1E-5);
   }
-  quiz_assert(equationStore.haveMoreApproximationSolutions(&globalContext) == hasMoreSolutions);
+  quiz_assert(equationStore.haveMoreApproximationSolutions() == hasMoreSolutions);
 }
 
 QUIZ_CASE(equation_solve) {
@@ -149,6 +149,14 @@ QUIZ_CASE(equation_solve) {
 
   double solutions17[] = {0};
   assert_equation_approximate_solve_to("R(y)=0", -900.0, 1000.0, 'y', solutions17, 1, false);
+
+  // Many roots, found in a single scan of the interval
+  double solutions18[] = {-1980.0, -1800.0, -1620.0, -1440.0, -1260.0, -1080.0, -900.0, -720.0, -540.0, -360.0};
+  assert_equation_approximate_solve_to("sin(x)=0", -2000.0, 2000.0, 'x', solutions18, 10, true);
+
+  // Roots where the function touches zero without changing sign
+  double solutions19[] = {0.0, 360.0, 720.0};
+  assert_equation_approximate_solve_to("cos(x)=1", -100.0, 1000.0, 'x', solutions19, 3, false);
 }
 
 }
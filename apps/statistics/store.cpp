@@ -16,6 +16,8 @@ Store::Store() :
   DoublePairStore(),
   m_barWidth(1.0),
   m_firstDrawnBarAbscissa(0.0),
+  m_numberOfBins{-1, -1, -1},
+  m_numberOfSortedPairs{-1, -1, -1},
   m_seriesEmpty{true, true, true},
   m_numberOfNonEmptySeries(0)
 {
@@ -31,25 +33,31 @@ uint32_t Store::barChecksum() const {
 /* Histogram bars */
 
 void Store::setBarWidth(double barWidth) {
-  if (barWidth > 0.0) {
+  if (barWidth > 0.0 && barWidth != m_barWidth) {
     m_barWidth = barWidth;
+    invalidateAllBins();
+  }
+}
+
+void Store::setFirstDrawnBarAbscissa(double firstDrawnBarAbscissa) {
+  if (firstDrawnBarAbscissa != m_firstDrawnBarAbscissa) {
+    m_firstDrawnBarAbscissa = firstDrawnBarAbscissa;
+    invalidateAllBins();
   }
 }
 
 double Store::heightOfBarAtIndex(int series, int index) const {
-  return sumOfValuesBetween(series, startOfBarAtIndex(series, index), endOfBarAtIndex(series, index));
+  computeBinsIfNeeded(series);
+  return heightOfBarNumber(series, m_firstBarNumber[series] + index);
 }
 
 double Store::heightOfBarAtValue(int series, double value) const {
-  double width = barWidth();
-  int barNumber = std::floor((value - m_firstDrawnBarAbscissa)/width);
-  double lowerBound = m_firstDrawnBarAbscissa + barNumber*width;
-  double upperBound = m_firstDrawnBarAbscissa + (barNumber+1)*width;
-  return sumOfValuesBetween(series, lowerBound, upperBound);
+  computeBinsIfNeeded(series);
+  return heightOfBarNumber(series, barNumberOfValue(value));
 }
 
 double Store::startOfBarAtIndex(int series, int index) const {
-  double firstBarAbscissa = m_firstDrawnBarAbscissa + m_barWidth*std::floor((minValue(series)- m_firstDrawnBarAbscissa)/m_barWidth);
+  double firstBarAbscissa = m_firstDrawnBarAbscissa + m_barWidth*barNumberOfValue(minValue(series));
   return firstBarAbscissa + index * m_barWidth;
 }
 
@@ -58,7 +66,7 @@ double Store::endOfBarAtIndex(int series, int index) const {
 }
 
 double Store::numberOfBars(int series) const {
-  double firstBarAbscissa = m_firstDrawnBarAbscissa + m_barWidth*std::floor((minValue(series)- m_firstDrawnBarAbscissa)/m_barWidth);
+  double firstBarAbscissa = m_firstDrawnBarAbscissa + m_barWidth*barNumberOfValue(minValue(series));
   return std::ceil((maxValue(series) - firstBarAbscissa)/m_barWidth)+1;
 }
 
@@ -199,22 +207,32 @@ double Store::squaredValueSum(int series) const {
 
 void Store::set(double f, int series, int i, int j) {
   DoublePairStore::set(f, series, i, j);
+  invalidateSeries(series);
   m_seriesEmpty[series] = sumOfOccurrences(series) == 0;
   updateNonEmptySeriesCount();
 }
 
 void Store::deletePairOfSeriesAtIndex(int series, int j) {
   DoublePairStore::deletePairOfSeriesAtIndex(series, j);
+  invalidateSeries(series);
   m_seriesEmpty[series] = sumOfOccurrences(series) == 0;
   updateNonEmptySeriesCount();
 }
 
 void Store::deleteAllPairsOfSeries(int series) {
   DoublePairStore::deleteAllPairsOfSeries(series);
+  invalidateSeries(series);
   m_seriesEmpty[series] = true;
   updateNonEmptySeriesCount();
 }
 
+void Store::resetColumn(int series, int i) {
+  DoublePairStore::resetColumn(series, i);
+  invalidateSeries(series);
+  m_seriesEmpty[series] = sumOfOccurrences(series) == 0;
+  updateNonEmptySeriesCount();
+}
+
 void Store::updateNonEmptySeriesCount() {
   int nonEmptySeriesCount = 0;
   for (int i = 0; i< k_numberOfSeries; i++) {
@@ -231,48 +249,135 @@ double Store::defaultValue(int series, int i, int j) const {
   return i == 0 ? DoublePairStore::defaultValue(series, i, j) : 1.0;
 }
 
-double Store::sumOfValuesBetween(int series, double x1, double x2) const {
-  double result = 0;
+double Store::barNumberOfValue(double value) const {
+  double barNumber = std::floor((value - m_firstDrawnBarAbscissa)/m_barWidth);
+  /* The rounding of the division can shift the value to a neighbouring bar:
+   * check it against the bounds of the bar, as they are computed everywhere
+   * else. */
+  if (value < m_firstDrawnBarAbscissa + barNumber*m_barWidth) {
+    barNumber--;
+  } else if (value >= m_firstDrawnBarAbscissa + (barNumber+1)*m_barWidth) {
+    barNumber++;
+  }
+  return barNumber;
+}
+
+double Store::heightOfBarNumber(int series, double barNumber) const {
+  assert(m_numberOfBins[series] >= 0);
+  const double * barNumbers = m_binBarNumbers[series];
+  int lower = 0;
+  int upper = m_numberOfBins[series];
+  while (lower < upper) {
+    int middle = (lower + upper)/2;
+    if (barNumbers[middle] < barNumber) {
+      lower = middle + 1;
+    } else {
+      upper = middle;
+    }
+  }
+  if (lower < m_numberOfBins[series] && barNumbers[lower] == barNumber) {
+    return m_binHeights[series][lower];
+  }
+  return 0.0;
+}
+
+void Store::computeBinsIfNeeded(int series) const {
+  if (m_numberOfBins[series] >= 0) {
+    return;
+  }
+  double * barNumbers = m_binBarNumbers[series];
+  double * heights = m_binHeights[series];
+  int numberOfBins = 0;
   for (int k = 0; k < numberOfPairsOfSeries(series); k++) {
-    if (m_data[series][0][k] < x2 && x1 <= m_data[series][0][k]) {
-      result += m_data[series][1][k];
+    double barNumber = barNumberOfValue(m_data[series][0][k]);
+    if (!std::isfinite(barNumber)) {
+      continue;
     }
+    // Insert the value in the sorted bins, there are at most k_maxNumberOfPairs
+    int index = numberOfBins;
+    while (index > 0 && barNumbers[index-1] > barNumber) {
+      index--;
+    }
+    if (index > 0 && barNumbers[index-1] == barNumber) {
+      heights[index-1] += m_data[series][1][k];
+      continue;
+    }
+    for (int i = numberOfBins; i > index; i--) {
+      barNumbers[i] = barNumbers[i-1];
+      heights[i] = heights[i-1];
+    }
+    barNumbers[index] = barNumber;
+    heights[index] = m_data[series][1][k];
+    numberOfBins++;
+  }
+  m_numberOfBins[series] = numberOfBins;
+  m_firstBarNumber[series] = barNumberOfValue(minValue(series));
+}
+
+void Store::invalidateAllBins() {
+  for (int i = 0; i < k_numberOfSeries; i++) {
+    invalidateBins(i);
   }
-  return result;
 }
 
 double Store::sortedElementAtCumulatedFrequency(int series, double k, bool createMiddleElement) const {
-  // TODO: use an other algorithm (ex quickselect) to avoid quadratic complexity
   assert(k >= 0.0 && k <= 1.0);
   double totalNumberOfElements = sumOfOccurrences(series);
   double numberOfElementsAtFrequencyK = totalNumberOfElements * k;
-
-  double bufferValues[numberOfPairsOfSeries(series)];
-  memcpy(bufferValues, m_data[series][0], numberOfPairsOfSeries(series)*sizeof(double));
-  int sortedElementIndex = 0;
-  double cumulatedNumberOfElements = 0.0;
-  while (cumulatedNumberOfElements < numberOfElementsAtFrequencyK-DBL_EPSILON) {
-    sortedElementIndex = minIndex(bufferValues, numberOfPairsOfSeries(series));
-    bufferValues[sortedElementIndex] = DBL_MAX;
-    cumulatedNumberOfElements += m_data[series][1][sortedElementIndex];
-  }
-  if (createMiddleElement && std::fabs(cumulatedNumberOfElements - numberOfElementsAtFrequencyK) < DBL_EPSILON) {
-    int nextElementIndex = minIndex(bufferValues, numberOfPairsOfSeries(series));
-    if (bufferValues[nextElementIndex] != DBL_MAX) {
-      return (m_data[series][0][sortedElementIndex] + m_data[series][0][nextElementIndex]) / 2.0;
+  computeSortedIndexesIfNeeded(series);
+  const uint8_t * sortedIndexes = m_sortedIndexes[series];
+  const double * cumulatedOccurrences = m_cumulatedOccurrences[series];
+  int numberOfPairs = m_numberOfSortedPairs[series];
+  assert(numberOfPairs > 0);
+  /* Find the first sorted value at which the cumulated occurrences reach
+   * numberOfElementsAtFrequencyK. Occurrences are positive, so the cumulated
+   * occurrences are sorted. */
+  int lower = 0;
+  int upper = numberOfPairs - 1;
+  while (lower < upper) {
+    int middle = (lower + upper)/2;
+    if (cumulatedOccurrences[middle] < numberOfElementsAtFrequencyK-DBL_EPSILON) {
+      lower = middle + 1;
+    } else {
+      upper = middle;
     }
   }
+  int sortedElementIndex = sortedIndexes[lower];
+  if (createMiddleElement && std::fabs(cumulatedOccurrences[lower] - numberOfElementsAtFrequencyK) < DBL_EPSILON && lower + 1 < numberOfPairs) {
+    return (m_data[series][0][sortedElementIndex] + m_data[series][0][sortedIndexes[lower+1]]) / 2.0;
+  }
   return m_data[series][0][sortedElementIndex];
 }
 
-int Store::minIndex(double * bufferValues, int bufferLength) const {
-  int index = 0;
-  for (int i = 1; i < bufferLength; i++) {
-    if (bufferValues[index] > bufferValues[i]) {
-      index = i;
+void Store::computeSortedIndexesIfNeeded(int series) const {
+  if (m_numberOfSortedPairs[series] >= 0) {
+    return;
+  }
+  static_assert(k_maxNumberOfPairs <= UINT8_MAX + 1, "Pair indexes should fit in a uint8_t");
+  uint8_t * sortedIndexes = m_sortedIndexes[series];
+  int numberOfPairs = numberOfPairsOfSeries(series);
+  /* Stable insertion sort: equal values keep the order of the store. It is
+   * only run once per edition of the series. */
+  for (int k = 0; k < numberOfPairs; k++) {
+    double value = m_data[series][0][k];
+    int index = k;
+    while (index > 0 && m_data[series][0][sortedIndexes[index-1]] > value) {
+      sortedIndexes[index] = sortedIndexes[index-1];
+      index--;
     }
+    sortedIndexes[index] = k;
   }
-  return index;
+  double cumulatedOccurrences = 0.0;
+  for (int k = 0; k < numberOfPairs; k++) {
+    cumulatedOccurrences += m_data[series][1][sortedIndexes[k]];
+    m_cumulatedOccurrences[series][k] = cumulatedOccurrences;
+  }
+  m_numberOfSortedPairs[series] = numberOfPairs;
+}
+
+void Store::invalidateSeries(int series) {
+  invalidateBins(series);
+  m_numberOfSortedPairs[series] = -1;
 }
 
 }
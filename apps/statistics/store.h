@@ -14,7 +14,7 @@ public:
   double barWidth() const { return m_barWidth; }
   void setBarWidth(double barWidth);
   double firstDrawnBarAbscissa() const { return m_firstDrawnBarAbscissa; }
-  void setFirstDrawnBarAbscissa(double firstDrawnBarAbscissa) { m_firstDrawnBarAbscissa = firstDrawnBarAbscissa;}
+  void setFirstDrawnBarAbscissa(double firstDrawnBarAbscissa);
   double heightOfBarAtIndex(int series, int index) const;
   double heightOfBarAtValue(int series, double value) const;
   double startOfBarAtIndex(int series, int index) const;
@@ -53,17 +53,41 @@ public:
   void set(double f, int series, int i, int j) override;
   void deletePairOfSeriesAtIndex(int series, int j) override;
   void deleteAllPairsOfSeries(int series) override;
+  void resetColumn(int series, int i) override;
 
   void updateNonEmptySeriesCount();
 
 private:
   double defaultValue(int series, int i, int j) const override;
-  double sumOfValuesBetween(int series, double x1, double x2) const;
   double sortedElementAtCumulatedFrequency(int series, double k, bool createMiddleElement = false) const;
-  int minIndex(double * bufferValues, int bufferLength) const;
+  void computeSortedIndexesIfNeeded(int series) const;
+  void invalidateSeries(int series);
+  // Histogram bins
+  double barNumberOfValue(double value) const;
+  double heightOfBarNumber(int series, double barNumber) const;
+  void computeBinsIfNeeded(int series) const;
+  void invalidateBins(int series) { m_numberOfBins[series] = -1; }
+  void invalidateAllBins();
   // Histogram bars
   double m_barWidth;
   double m_firstDrawnBarAbscissa;
+  /* The non-empty bins of each series are memoized, sorted by bar number. A
+   * bar number n stands for the bar [first + n*width, first + (n+1)*width[.
+   * Bar numbers are doubles as they can outgrow an int when the first bar is
+   * far from the data. m_numberOfBins is -1 when the bins of the series have
+   * to be recomputed. They take 4836 bytes of the Store, which lives as long
+   * as the app snapshot. */
+  mutable int m_numberOfBins[k_numberOfSeries];
+  mutable double m_firstBarNumber[k_numberOfSeries];
+  mutable double m_binBarNumbers[k_numberOfSeries][k_maxNumberOfPairs];
+  mutable double m_binHeights[k_numberOfSeries][k_maxNumberOfPairs];
+  /* The indexes of the pairs of each series are memoized, sorted by value, with
+   * the cumulated occurrences of the sorted values, so that quantiles are
+   * found by a binary search. m_numberOfSortedPairs is -1 when they have to be
+   * recomputed. They take 2712 bytes. */
+  mutable int m_numberOfSortedPairs[k_numberOfSeries];
+  mutable uint8_t m_sortedIndexes[k_numberOfSeries][k_maxNumberOfPairs];
+  mutable double m_cumulatedOccurrences[k_numberOfSeries][k_maxNumberOfPairs];
   bool m_seriesEmpty[k_numberOfSeries];
   int m_numberOfNonEmptySeries;
 };
@@ -207,4 +207,97 @@ QUIZ_CASE(data_statistics) {
 
 }
 
+double height_of_bar_between(Store * store, int series, double lowerBound, double upperBound) {
+  double result = 0.0;
+  for (int k = 0; k < store->numberOfPairsOfSeries(series); k++) {
+    double value = store->get(series, 0, k);
+    if (lowerBound <= value && value < upperBound) {
+      result += store->get(series, 1, k);
+    }
+  }
+  return result;
+}
+
+void assert_bar_heights_are_sums_of_occurrences(Store * store, int series) {
+  double width = store->barWidth();
+  double first = store->firstDrawnBarAbscissa();
+  for (int i = 0; i < store->numberOfBars(series); i++) {
+    double lowerBound = store->startOfBarAtIndex(series, i);
+    quiz_assert(store->heightOfBarAtIndex(series, i) == height_of_bar_between(store, series, lowerBound, store->endOfBarAtIndex(series, i)));
+  }
+  for (double x = -20.0; x < 20.0; x += 0.25) {
+    double barNumber = std::floor((x - first)/width);
+    double expected = height_of_bar_between(store, series, first + barNumber*width, first + (barNumber+1)*width);
+    quiz_assert(store->heightOfBarAtValue(series, x) == expected);
+  }
+}
+
+QUIZ_CASE(statistics_histogram_bars) {
+  Store store;
+  int series = 1;
+  double values[] = {1.0, 2.5, -3.0, 2.0, 7.25, 1.5, 2.0, 0.0, -0.5};
+  double occurrences[] = {2.0, 1.0, 3.0, 4.0, 1.0, 0.0, 2.0, 5.0, 1.0};
+  for (int i = 0; i < 9; i++) {
+    store.set(values[i], series, 0, i);
+    store.set(occurrences[i], series, 1, i);
+  }
+  assert_bar_heights_are_sums_of_occurrences(&store, series);
+  quiz_assert(store.heightOfBarAtValue(series, 2.0) == 7.0);
+
+  // The bars follow the bar parameters
+  store.setBarWidth(0.5);
+  assert_bar_heights_are_sums_of_occurrences(&store, series);
+  quiz_assert(store.heightOfBarAtValue(series, 2.0) == 6.0);
+  store.setFirstDrawnBarAbscissa(-0.25);
+  assert_bar_heights_are_sums_of_occurrences(&store, series);
+  store.setBarWidth(3.0);
+  assert_bar_heights_are_sums_of_occurrences(&store, series);
+
+  // The bars follow the data
+  store.set(4.0, series, 1, 3);
+  assert_bar_heights_are_sums_of_occurrences(&store, series);
+  store.deletePairOfSeriesAtIndex(series, 2);
+  assert_bar_heights_are_sums_of_occurrences(&store, series);
+  store.resetColumn(series, 1);
+  assert_bar_heights_are_sums_of_occurrences(&store, series);
+  store.deleteAllPairsOfSeries(series);
+  quiz_assert(store.heightOfBarAtValue(series, 2.0) == 0.0);
+}
+
+QUIZ_CASE(statistics_quantiles_follow_edits) {
+  Store store;
+  int series = 2;
+  // Fill the series with 0, 1, ..., 99 in a scrambled order
+  for (int i = 0; i < Store::k_maxNumberOfPairs; i++) {
+    store.set((37*i) % Store::k_maxNumberOfPairs, series, 0, i);
+    store.set(1.0, series, 1, i);
+  }
+  quiz_assert(store.firstQuartile(series) == 24.0);
+  quiz_assert(store.median(series) == 49.5);
+  quiz_assert(store.thirdQuartile(series) == 74.0);
+
+  // Value 0 is the first pair
+  store.set(10.0, series, 1, 0);
+  quiz_assert(store.firstQuartile(series) == 18.0);
+  quiz_assert(store.median(series) == 45.0);
+  store.set(200.0, series, 0, 0);
+  quiz_assert(store.median(series) == 55.0);
+  store.deletePairOfSeriesAtIndex(series, 0);
+  quiz_assert(store.median(series) == 50.0);
+  quiz_assert(store.thirdQuartile(series) == 75.0);
+}
+
+QUIZ_CASE(statistics_quantiles_at_null_cumulated_frequency) {
+  Store store;
+  int series = 0;
+  double values[] = {3.0, 1.0, 2.0};
+  for (int i = 0; i < 3; i++) {
+    store.set(values[i], series, 0, i);
+    store.set(1.0E-17, series, 1, i);
+  }
+  // The quartiles are reached before any value: they are the smallest value
+  quiz_assert(store.firstQuartile(series) == 1.0);
+  quiz_assert(store.thirdQuartile(series) == 1.0);
+}
+
 }
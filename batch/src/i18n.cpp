@@ -0,0 +1,14 @@
+#include <escher/i18n.h>
+
+namespace I18n {
+
+const char * translate(Message m, Language l) {
+  return nullptr;
+}
+
+int numberOfLanguages() {
+  return 0;
+}
+
+}
+
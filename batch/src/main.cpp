@@ -0,0 +1,155 @@
+#include <poincare.h>
+#include <poincare/init.h>
+#include <poincare/exception_checkpoint.h>
+#include <ion.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../poincare/test/special_chars.h"
+
+/* The batch driver reads expressions line by line, from the file given as
+ * last argument or from the standard input, and runs each of them through
+ * Poincare as the Calculation app does: it parses and simplifies it into an
+ * exact result, then approximates that result. Each input line yields one
+ * line of tab-separated fields:
+ *   input, exact result, approximate result,
+ *   parse and simplify time (ns), approximation time (ns)
+ * A summary is written on the standard error at the end.
+ *
+ * Usage:
+ *   make PLATFORM=blackbox batch.bin
+ *   ./batch.bin [--angle-unit degree|radian] [--complex-format cartesian|polar]
+ *               [--significant-digits n] [file]
+ *
+ * As in the Poincare tests, special characters are written in ASCII: P for π,
+ * X for e, I for i, R for √, E for the exponent of decimals and > for the
+ * store arrow. */
+
+using namespace Poincare;
+
+constexpr static int k_bufferSize = 1024;
+
+static void usage() {
+  fprintf(stderr, "Usage: batch.bin [--angle-unit degree|radian] [--complex-format cartesian|polar] [--significant-digits n] [file]\n");
+  exit(1);
+}
+
+static void parseArguments(int argc, char * argv[], FILE ** input) {
+  Preferences * preferences = Preferences::sharedPreferences();
+  for (int i = 1; i < argc; i++) {
+    const char * argument = argv[i];
+    const char * value = i + 1 < argc ? argv[i+1] : nullptr;
+    if (strcmp(argument, "--angle-unit") == 0 && value != nullptr) {
+      if (strcmp(value, "degree") == 0) {
+        preferences->setAngleUnit(Preferences::AngleUnit::Degree);
+      } else if (strcmp(value, "radian") == 0) {
+        preferences->setAngleUnit(Preferences::AngleUnit::Radian);
+      } else {
+        usage();
+      }
+      i++;
+    } else if (strcmp(argument, "--complex-format") == 0 && value != nullptr) {
+      if (strcmp(value, "cartesian") == 0) {
+        preferences->setComplexFormat(Preferences::ComplexFormat::Cartesian);
+      } else if (strcmp(value, "polar") == 0) {
+        preferences->setComplexFormat(Preferences::ComplexFormat::Polar);
+      } else {
+        usage();
+      }
+      i++;
+    } else if (strcmp(argument, "--significant-digits") == 0 && value != nullptr) {
+      int numberOfSignificantDigits = atoi(value);
+      if (numberOfSignificantDigits < 1 || numberOfSignificantDigits > PrintFloat::k_numberOfStoredSignificantDigits) {
+        usage();
+      }
+      preferences->setNumberOfSignificantDigits(numberOfSignificantDigits);
+      i++;
+    } else if (argument[0] != '-' && i == argc - 1) {
+      *input = fopen(argument, "r");
+      if (*input == nullptr) {
+        fprintf(stderr, "Cannot open %s\n", argument);
+        exit(1);
+      }
+    } else {
+      usage();
+    }
+  }
+}
+
+/* Evaluate one line into exact and approximate. The ExceptionCheckpoint must
+ * be in a function which stays in the call tree during the evaluation, and
+ * the results are serialized before leaving it, as the pool is freed on an
+ * exception. Return false if the pool overflowed. */
+static bool evaluate(const char * text, Context & context, char * exact, char * approximate, double * simplificationTime, double * approximationTime) {
+  Preferences * preferences = Preferences::sharedPreferences();
+  Poincare::ExceptionCheckpoint ecp;
+  if (!ExceptionRun(ecp)) {
+    return false;
+  }
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  Expression exactOutput = Expression::ParseAndSimplify(text, context, preferences->angleUnit());
+  std::chrono::steady_clock::time_point simplified = std::chrono::steady_clock::now();
+  Expression approximateOutput = exactOutput.approximate<double>(context, preferences->angleUnit(), preferences->complexFormat());
+  std::chrono::steady_clock::time_point approximated = std::chrono::steady_clock::now();
+  *simplificationTime = std::chrono::duration<double, std::nano>(simplified - start).count();
+  *approximationTime = std::chrono::duration<double, std::nano>(approximated - simplified).count();
+  exactOutput.serialize(exact, k_bufferSize, preferences->displayMode(), preferences->numberOfSignificantDigits());
+  approximateOutput.serialize(approximate, k_bufferSize, preferences->displayMode(), preferences->numberOfSignificantDigits());
+  return true;
+}
+
+void ion_main(int argc, char * argv[]) {
+  Poincare::init();
+  FILE * input = stdin;
+  parseArguments(argc, argv, &input);
+
+  GlobalContext context;
+  char line[k_bufferSize];
+  char exact[k_bufferSize];
+  char approximate[k_bufferSize];
+  int numberOfExpressions = 0;
+  int numberOfFailures = 0;
+  int lineNumber = 0;
+  double totalSimplificationTime = 0.0;
+  double totalApproximationTime = 0.0;
+  while (fgets(line, sizeof(line), input) != nullptr) {
+    lineNumber++;
+    if (strchr(line, '\n') == nullptr && !feof(input)) {
+      // The line does not fit in the buffer: skip the rest of it
+      int c;
+      while ((c = fgetc(input)) != '\n' && c != EOF) {
+      }
+      fprintf(stderr, "Line %d is longer than %d characters\n", lineNumber, k_bufferSize - 2);
+      numberOfExpressions++;
+      numberOfFailures++;
+      printf("line %d too long\terror\terror\t\t\n", lineNumber);
+      continue;
+    }
+    line[strcspn(line, "\r\n")] = 0;
+    if (line[0] == 0) {
+      continue;
+    }
+    char text[k_bufferSize];
+    strlcpy(text, line, sizeof(text));
+    translate_in_special_chars(text);
+    double simplificationTime = 0.0;
+    double approximationTime = 0.0;
+    numberOfExpressions++;
+    if (!evaluate(text, context, exact, approximate, &simplificationTime, &approximationTime)) {
+      numberOfFailures++;
+      printf("%s\terror\terror\t\t\n", line);
+      continue;
+    }
+    translate_in_ASCII_chars(exact);
+    translate_in_ASCII_chars(approximate);
+    printf("%s\t%s\t%s\t%.0f\t%.0f\n", line, exact, approximate, simplificationTime, approximationTime);
+    totalSimplificationTime += simplificationTime;
+    totalApproximationTime += approximationTime;
+  }
+  if (input != stdin) {
+    fclose(input);
+  }
+  fflush(stdout);
+  fprintf(stderr, "%d expressions (%d errors): parse and simplify %.0f ns, approximate %.0f ns\n", numberOfExpressions, numberOfFailures, totalSimplificationTime, totalApproximationTime);
+}
@@ -3,6 +3,7 @@ USE_LIBA ?= 0
 EXE = bin
 EPSILON_ONBOARDING_APP = 0
 EPSILON_SOFTWARE_UPDATE_PROMPT = 0
+POINCARE_MULTITHREAD ?= 1
 
 ifeq ($(DEBUG),1)
 else
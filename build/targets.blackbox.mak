@@ -18,6 +18,10 @@ compare: ion/src/blackbox/compare.o libepsilon_first.o libepsilon_second.o
 	@echo "LD      $@"
 	$(Q) $(LD) $^ $(LDFLAGS) -L. -o $@
 
+# Batch evaluation
+
+include batch/Makefile
+
 # Integration tests
 
 .PHONY: tests/%.run
@@ -70,7 +70,11 @@ KDRect View::redraw(KDRect rect, KDRect forceRedrawRect) {
     KDPoint absOrigin = absoluteOrigin();
     KDRect absRect = rectNeedingRedraw.translatedBy(absOrigin);
     KDRect absClippingRect = absoluteVisibleFrame().intersectedWith(absRect);
+#if ESCHER_COMPOSITOR
+    KDContext * ctx = KDCompositorContext::sharedContext();
+#else
     KDContext * ctx = KDIonContext::sharedContext();
+#endif
     ctx->setOrigin(absOrigin);
     ctx->setClippingRect(absClippingRect);
     this->drawRect(ctx, rectNeedingRedraw);
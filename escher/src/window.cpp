@@ -3,6 +3,9 @@
 extern "C" {
 #include <assert.h>
 }
+#if ESCHER_COMPOSITOR_LOGGING
+#include <stdio.h>
+#endif
 
 Window::Window() :
   m_contentView(nullptr)
@@ -13,8 +16,30 @@ void Window::redraw(bool force) {
   if (force) {
     markRectAsDirty(bounds());
   }
+#if ESCHER_COMPOSITOR
+  /* The views are drawn in RAM, and only the tiles they changed are pushed to
+   * the screen, at once. */
+  KDCompositorContext * compositor = KDCompositorContext::sharedContext();
+  if (force) {
+    compositor->invalidate();
+  }
+  View::redraw(bounds());
+  Ion::Display::waitForVBlank();
+  compositor->flush();
+#if ESCHER_COMPOSITOR_LOGGING
+  static int sNumberOfFrames = 0;
+  const KDCompositorContext::FrameStatistics & statistics = compositor->lastFrameStatistics();
+  printf("Frame %d: %d pixels drawn, overdraw %.2f, %d tiles and %d bytes pushed\n",
+      sNumberOfFrames++,
+      statistics.numberOfPixelsDrawn,
+      statistics.numberOfDistinctPixelsDrawn > 0 ? (float)statistics.numberOfPixelsDrawn/statistics.numberOfDistinctPixelsDrawn : 0.0f,
+      statistics.numberOfPushedTiles,
+      statistics.numberOfPushedBytes);
+#endif
+#else
   Ion::Display::waitForVBlank();
   View::redraw(bounds());
+#endif
 }
 
 void Window::setContentView(View * contentView) {
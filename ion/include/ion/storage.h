@@ -2,6 +2,7 @@
 #define ION_STORAGE_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 namespace Ion {
 
@@ -62,6 +63,9 @@ public:
   int numberOfRecordsWithExtension(const char * extension);
   Record recordWithExtensionAtIndex(const char * extension, int index);
   Record recordNamed(const char * name);
+  /* The buffer might be written without going through the Storage, by a DFU
+   * transfer for instance. The index then has to be rebuilt. */
+  void rebuildIndex();
   typedef uint16_t record_size_t;
   constexpr static size_t k_storageSize = 16384;
 private:
@@ -85,6 +89,20 @@ private:
   size_t overrideNameAtPosition(char * position, const char * name);
   size_t overrideValueAtPosition(char * position, const void * data, record_size_t size);
 
+  /* Index: open-addressing hash table, with linear probing, from the name
+   * CRC32 of the records to their offset in m_buffer. It spares scanning the
+   * buffer and hashing every record name on each access. When there are too
+   * many records to index, records are found by scanning the buffer. */
+  constexpr static int k_indexSize = 128; // Must be a power of 2
+  constexpr static int k_maxNumberOfIndexedRecords = 3*k_indexSize/4;
+  constexpr static uint16_t k_emptyIndexSlot = 0xFFFF;
+  char * pointerOfRecord(const Record record);
+  char * scanForRecord(const Record record);
+  int indexSlot(uint32_t nameCRC32) const;
+  void addToIndex(uint32_t nameCRC32, char * recordStart);
+  void removeFromIndex(uint32_t nameCRC32);
+  void slideIndex(char * position, int delta);
+
   bool isNameTaken(const char * name, Record * recordToExclude = nullptr);
   static bool nameCompliant(const char * name);
   char * endBuffer();
@@ -110,6 +128,10 @@ private:
   uint32_t m_magicHeader;
   char m_buffer[k_storageSize];
   uint32_t m_magicFooter;
+  uint32_t m_indexedNameCRC32s[k_indexSize];
+  uint16_t m_indexedOffsets[k_indexSize];
+  int m_numberOfIndexedRecords;
+  bool m_indexIsComplete;
 };
 
 }
@@ -1,23 +1,56 @@
 #include <ion.h>
 
+/* CRC32 with the polynomial 0x04C11DB7, processing each word from its most
+ * significant byte, without reflection nor final XOR. This matches the
+ * hardware CRC unit of the device.
+ * The CRC is computed a word at a time ("slicing-by-4"): table[k][b] is the
+ * contribution of the byte b followed by k null bytes. The tables are
+ * generated at compile time. */
+
 constexpr uint32_t polynomial = 0x04C11DB7;
 
-static uint32_t crc32(uint32_t crc, uint8_t data) {
-    crc ^= data << 24;
-    for (int i=8; i--;) {
-      crc = crc & 0x80000000 ? ((crc<<1)^polynomial) : (crc << 1);
-    }
-    return crc;
+constexpr uint32_t crc32Bits(uint32_t crc, int numberOfBits) {
+  return numberOfBits == 0 ? crc : crc32Bits(crc & 0x80000000 ? ((crc<<1)^polynomial) : (crc << 1), numberOfBits-1);
+}
+
+constexpr uint32_t crc32Byte(uint32_t byte) {
+  return crc32Bits(byte << 24, 8);
 }
 
+constexpr uint32_t crc32Slice(uint32_t byte, int slice) {
+  return slice == 0 ? crc32Byte(byte) : (crc32Slice(byte, slice-1) << 8) ^ crc32Byte(crc32Slice(byte, slice-1) >> 24);
+}
+
+template<int... I> struct Indices {};
+template<int N, int... I> struct MakeIndices : MakeIndices<N-1, N-1, I...> {};
+template<int... I> struct MakeIndices<0, I...> { typedef Indices<I...> type; };
+
+struct Table {
+  uint32_t slices[4][256];
+};
+
+template<int... I>
+constexpr Table makeTable(Indices<I...>) {
+  return Table{{
+    {crc32Slice(I, 0)...},
+    {crc32Slice(I, 1)...},
+    {crc32Slice(I, 2)...},
+    {crc32Slice(I, 3)...}
+  }};
+}
+
+constexpr static Table table = makeTable(MakeIndices<256>::type());
+
+static_assert(table.slices[0][1] == polynomial, "CRC32 table is not generated correctly");
+
 uint32_t Ion::crc32(const uint32_t * data, size_t length) {
   uint32_t crc = 0xFFFFFFFF;
   for (size_t i=0; i<length; i++) {
-    // FIXME: Assumes little-endian byte order!
-    crc = ::crc32(crc, (uint8_t)((data[i] >> 24) & 0xFF));
-    crc = ::crc32(crc, (uint8_t)((data[i] >> 16) & 0xFF));
-    crc = ::crc32(crc, (uint8_t)((data[i] >> 8) & 0xFF));
-    crc = ::crc32(crc, (uint8_t)(data[i] & 0xFF));
+    crc ^= data[i];
+    crc = table.slices[3][crc >> 24]
+      ^ table.slices[2][(crc >> 16) & 0xFF]
+      ^ table.slices[1][(crc >> 8) & 0xFF]
+      ^ table.slices[0][crc & 0xFF];
   }
   return crc;
 }
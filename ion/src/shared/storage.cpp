@@ -56,12 +56,17 @@ Storage::Record::Record(const char * name) {
 Storage::Storage() :
   m_magicHeader(Magic),
   m_buffer(),
-  m_magicFooter(Magic)
+  m_magicFooter(Magic),
+  m_indexedNameCRC32s(),
+  m_indexedOffsets(),
+  m_numberOfIndexedRecords(0),
+  m_indexIsComplete(true)
 {
   assert(m_magicHeader == Magic);
   assert(m_magicFooter == Magic);
   // Set the size of the first record to 0
   overrideSizeAtPosition(m_buffer, 0);
+  rebuildIndex();
 }
 
 size_t Storage::availableSize() {
@@ -81,6 +86,7 @@ Storage::Record::ErrorStatus Storage::createRecord(const char * name, const void
   }
   // Find the end of data
   char * newRecord = endBuffer();
+  addToIndex(Record(name).m_nameCRC32, newRecord);
   // Fill totalSize
   newRecord += overrideSizeAtPosition(newRecord, (record_size_t)recordSize);
   // Fill name
@@ -125,23 +131,31 @@ Storage::Record Storage::recordWithExtensionAtIndex(const char * extension, int
 }
 
 Storage::Record Storage::recordNamed(const char * name) {
-  for (char * p : *this) {
-    const char * currentName = nameOfRecordStarting(p);
-    if (strcmp(currentName, name) == 0) {
-      return Record(name);
-    }
+  Record r(name);
+  char * p = pointerOfRecord(r);
+  if (p != nullptr && strcmp(nameOfRecordStarting(p), name) == 0) {
+    return r;
   }
   return Record();
 }
 
-const char * Storage::nameOfRecord(const Record record) {
+void Storage::rebuildIndex() {
+  for (int i = 0; i < k_indexSize; i++) {
+    m_indexedOffsets[i] = k_emptyIndexSlot;
+  }
+  m_numberOfIndexedRecords = 0;
+  m_indexIsComplete = true;
   for (char * p : *this) {
-    Record currentRecord(nameOfRecordStarting(p));
-    if (record == currentRecord) {
-      return nameOfRecordStarting(p);
-    }
+    addToIndex(Record(nameOfRecordStarting(p)).m_nameCRC32, p);
   }
-  return nullptr;
+}
+
+const char * Storage::nameOfRecord(const Record record) {
+  char * p = pointerOfRecord(record);
+  if (p == nullptr) {
+    return nullptr;
+  }
+  return nameOfRecordStarting(p);
 }
 
 Storage::Record::ErrorStatus Storage::setNameOfRecord(Record record, const char * name) {
@@ -152,61 +166,141 @@ Storage::Record::ErrorStatus Storage::setNameOfRecord(Record record, const char
     return Record::ErrorStatus::NameTaken;
   }
   size_t nameSize = strlen(name)+1;
-  for (char * p : *this) {
-    Record currentRecord(nameOfRecordStarting(p));
-    if (record == currentRecord) {
-      size_t previousNameSize = strlen(nameOfRecordStarting(p))+1;
-      record_size_t previousRecordSize = sizeOfRecordStarting(p);
-      size_t newRecordSize = previousRecordSize-previousNameSize+nameSize;
-      if (newRecordSize >= k_maxRecordSize || !slideBuffer(p+sizeof(record_size_t)+previousNameSize, nameSize-previousNameSize)) {
-        return Record::ErrorStatus::NotEnoughSpaceAvailable;
-      }
-      overrideSizeAtPosition(p, newRecordSize);
-      overrideNameAtPosition(p+sizeof(record_size_t), name);
-      return Record::ErrorStatus::None;
-    }
+  char * p = pointerOfRecord(record);
+  if (p == nullptr) {
+    return Record::ErrorStatus::RecordDoesNotExist;
+  }
+  size_t previousNameSize = strlen(nameOfRecordStarting(p))+1;
+  record_size_t previousRecordSize = sizeOfRecordStarting(p);
+  size_t newRecordSize = previousRecordSize-previousNameSize+nameSize;
+  if (newRecordSize >= k_maxRecordSize || !slideBuffer(p+sizeof(record_size_t)+previousNameSize, nameSize-previousNameSize)) {
+    return Record::ErrorStatus::NotEnoughSpaceAvailable;
   }
-  return Record::ErrorStatus::RecordDoesNotExist;
+  overrideSizeAtPosition(p, newRecordSize);
+  overrideNameAtPosition(p+sizeof(record_size_t), name);
+  removeFromIndex(record.m_nameCRC32);
+  addToIndex(Record(name).m_nameCRC32, p);
+  return Record::ErrorStatus::None;
 }
 
 Storage::Record::Data Storage::valueOfRecord(const Record record) {
- for (char * p : *this) {
-    Record currentRecord(nameOfRecordStarting(p));
-    if (record == currentRecord) {
-      const char * name = nameOfRecordStarting(p);
-      record_size_t size = sizeOfRecordStarting(p);
-      const void * value = valueOfRecordStarting(p);
-      return {.buffer= value, .size= size-strlen(name)-1-sizeof(record_size_t)};
-    }
+  char * p = pointerOfRecord(record);
+  if (p == nullptr) {
+    return {.buffer= nullptr, .size= 0};
   }
-  return {.buffer= nullptr, .size= 0};
+  const char * name = nameOfRecordStarting(p);
+  record_size_t size = sizeOfRecordStarting(p);
+  const void * value = valueOfRecordStarting(p);
+  return {.buffer= value, .size= size-strlen(name)-1-sizeof(record_size_t)};
 }
 
 Storage::Record::ErrorStatus Storage::setValueOfRecord(Record record, Record::Data data) {
-  for (char * p : *this) {
-    Record currentRecord(nameOfRecordStarting(p));
-    if (record == currentRecord) {
-      record_size_t previousRecordSize = sizeOfRecordStarting(p);
-      const char * name = nameOfRecordStarting(p);
-      size_t newRecordSize = sizeOfRecord(name, data.size);
-      if (newRecordSize >= k_maxRecordSize || !slideBuffer(p+previousRecordSize, newRecordSize-previousRecordSize)) {
-        return Record::ErrorStatus::NotEnoughSpaceAvailable;
-      }
-      record_size_t nameSize = strlen(name)+1;
-      overrideSizeAtPosition(p, newRecordSize);
-      overrideValueAtPosition(p+sizeof(record_size_t)+nameSize, data.buffer, data.size);
-      return Record::ErrorStatus::None;
-    }
+  char * p = pointerOfRecord(record);
+  if (p == nullptr) {
+    return Record::ErrorStatus::RecordDoesNotExist;
   }
-  return Record::ErrorStatus::RecordDoesNotExist;
+  record_size_t previousRecordSize = sizeOfRecordStarting(p);
+  const char * name = nameOfRecordStarting(p);
+  size_t newRecordSize = sizeOfRecord(name, data.size);
+  if (newRecordSize >= k_maxRecordSize || !slideBuffer(p+previousRecordSize, newRecordSize-previousRecordSize)) {
+    return Record::ErrorStatus::NotEnoughSpaceAvailable;
+  }
+  record_size_t nameSize = strlen(name)+1;
+  overrideSizeAtPosition(p, newRecordSize);
+  overrideValueAtPosition(p+sizeof(record_size_t)+nameSize, data.buffer, data.size);
+  return Record::ErrorStatus::None;
 }
 
 void Storage::destroyRecord(Record record) {
+  char * p = pointerOfRecord(record);
+  if (p == nullptr) {
+    return;
+  }
+  removeFromIndex(record.m_nameCRC32);
+  record_size_t previousRecordSize = sizeOfRecordStarting(p);
+  slideBuffer(p+previousRecordSize, -previousRecordSize);
+  if (!m_indexIsComplete) {
+    // Some records might fit in the index now
+    rebuildIndex();
+  }
+}
+
+char * Storage::pointerOfRecord(const Record record) {
+  if (record.isNull()) {
+    return nullptr;
+  }
+  int slot = indexSlot(record.m_nameCRC32);
+  if (slot >= 0) {
+    char * p = m_buffer + m_indexedOffsets[slot];
+    assert(Record(nameOfRecordStarting(p)) == record);
+    return p;
+  }
+  return m_indexIsComplete ? nullptr : scanForRecord(record);
+}
+
+char * Storage::scanForRecord(const Record record) {
   for (char * p : *this) {
     Record currentRecord(nameOfRecordStarting(p));
     if (record == currentRecord) {
-      record_size_t previousRecordSize = sizeOfRecordStarting(p);
-      slideBuffer(p+previousRecordSize, -previousRecordSize);
+      return p;
+    }
+  }
+  return nullptr;
+}
+
+int Storage::indexSlot(uint32_t nameCRC32) const {
+  int slot = nameCRC32 & (k_indexSize-1);
+  while (m_indexedOffsets[slot] != k_emptyIndexSlot) {
+    if (m_indexedNameCRC32s[slot] == nameCRC32) {
+      return slot;
+    }
+    slot = (slot+1) & (k_indexSize-1);
+  }
+  return -1;
+}
+
+void Storage::addToIndex(uint32_t nameCRC32, char * recordStart) {
+  if (m_numberOfIndexedRecords >= k_maxNumberOfIndexedRecords) {
+    m_indexIsComplete = false;
+    return;
+  }
+  int slot = nameCRC32 & (k_indexSize-1);
+  while (m_indexedOffsets[slot] != k_emptyIndexSlot) {
+    slot = (slot+1) & (k_indexSize-1);
+  }
+  m_indexedNameCRC32s[slot] = nameCRC32;
+  m_indexedOffsets[slot] = recordStart - m_buffer;
+  m_numberOfIndexedRecords++;
+}
+
+void Storage::removeFromIndex(uint32_t nameCRC32) {
+  int slot = indexSlot(nameCRC32);
+  if (slot < 0) {
+    return;
+  }
+  m_numberOfIndexedRecords--;
+  /* Shift back the following entries of the probing sequence which cannot be
+   * reached anymore once the slot is emptied. */
+  int next = slot;
+  while (true) {
+    next = (next+1) & (k_indexSize-1);
+    if (m_indexedOffsets[next] == k_emptyIndexSlot) {
+      break;
+    }
+    int idealSlot = m_indexedNameCRC32s[next] & (k_indexSize-1);
+    if (((next - idealSlot) & (k_indexSize-1)) >= ((next - slot) & (k_indexSize-1))) {
+      m_indexedNameCRC32s[slot] = m_indexedNameCRC32s[next];
+      m_indexedOffsets[slot] = m_indexedOffsets[next];
+      slot = next;
+    }
+  }
+  m_indexedOffsets[slot] = k_emptyIndexSlot;
+}
+
+void Storage::slideIndex(char * position, int delta) {
+  for (int i = 0; i < k_indexSize; i++) {
+    if (m_indexedOffsets[i] != k_emptyIndexSlot && m_buffer + m_indexedOffsets[i] >= position) {
+      m_indexedOffsets[i] += delta;
     }
   }
 }
@@ -266,16 +360,10 @@ bool Storage::isNameTaken(const char * name, Record * recordToExclude) {
   if (r == Record()) {
     return true;
   }
-  for (char * p : *this) {
-    Record s(nameOfRecordStarting(p));
-    if (recordToExclude && s == *recordToExclude) {
-      continue;
-    }
-    if (s == r) {
-      return true;
-    }
+  if (recordToExclude && r == *recordToExclude) {
+    return false;
   }
-  return false;
+  return pointerOfRecord(r) != nullptr;
 }
 
 bool Storage::nameCompliant(const char * name) {
@@ -314,6 +402,7 @@ bool Storage::slideBuffer(char * position, int delta) {
     return false;
   }
   memmove(position+delta, position, endBuffer()+sizeof(record_size_t)-position);
+  slideIndex(position, delta);
   return true;
 }
 
@@ -0,0 +1,45 @@
+#include <quiz_benchmark.h>
+#include <ion.h>
+#include <stdio.h>
+
+/* The previous bit-at-a-time implementation, as a reference */
+static uint32_t bitwise_crc32(const uint32_t * data, size_t length) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < length; i++) {
+    for (int byte = 3; byte >= 0; byte--) {
+      crc ^= ((data[i] >> (8*byte)) & 0xFF) << 24;
+      for (int bit = 0; bit < 8; bit++) {
+        crc = crc & 0x80000000 ? ((crc<<1)^0x04C11DB7) : (crc << 1);
+      }
+    }
+  }
+  return crc;
+}
+
+static void benchmark_crc32(const char * name, size_t length) {
+  uint32_t input[1024];
+  for (size_t i = 0; i < length; i++) {
+    input[i] = 0x9E3779B9*(i+1);
+  }
+  uint32_t sum = 0;
+  // Report the throughput as the duration of the CRC of a 4-byte word
+  int numberOfIterations = 200000/length;
+  double bitwise = quiz_benchmark(numberOfIterations, [&]() {
+      sum += bitwise_crc32(input, length);
+      input[0]++;
+    })/length;
+  double sliced = quiz_benchmark(numberOfIterations, [&]() {
+      sum += Ion::crc32(input, length);
+      input[0]++;
+    })/length;
+  quiz_benchmark_print(name, bitwise, sliced);
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "  (checksum %x)", sum);
+  quiz_print(buffer);
+}
+
+QUIZ_CASE(ion_benchmark_crc32) {
+  // A record name, and a storage record
+  benchmark_crc32("crc32 of 4 words, per word", 4);
+  benchmark_crc32("crc32 of 1024 words, per word", 1024);
+}
@@ -0,0 +1,85 @@
+#include <quiz_benchmark.h>
+#include <ion.h>
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace Ion;
+
+/* The reference is recordNamed followed by Record::value as they were before
+ * the index: the records are scanned once to compare their names, then once
+ * more to hash every name until the record is found. It runs on a copy of the
+ * records laid out as in the storage buffer: size, name, value. */
+
+static char sScannedBuffer[8192];
+static char * sScannedEnd = sScannedBuffer;
+
+static void addScannedRecord(const char * name, const void * value, size_t size) {
+  size_t nameSize = strlen(name)+1;
+  Storage::record_size_t recordSize = sizeof(Storage::record_size_t) + nameSize + size;
+  assert(sScannedEnd + recordSize <= sScannedBuffer + sizeof(sScannedBuffer));
+  memcpy(sScannedEnd, &recordSize, sizeof(recordSize));
+  memcpy(sScannedEnd + sizeof(recordSize), name, nameSize);
+  memcpy(sScannedEnd + sizeof(recordSize) + nameSize, value, size);
+  sScannedEnd += recordSize;
+}
+
+static Storage::record_size_t scannedRecordSize(const char * p) {
+  Storage::record_size_t size;
+  memcpy(&size, p, sizeof(size));
+  return size;
+}
+
+static Storage::Record scannedRecordNamed(const char * name) {
+  for (const char * p = sScannedBuffer; p < sScannedEnd; p += scannedRecordSize(p)) {
+    if (strcmp(p + sizeof(Storage::record_size_t), name) == 0) {
+      return Storage::Record(name);
+    }
+  }
+  return Storage::Record();
+}
+
+static Storage::Record::Data scannedValue(const Storage::Record record) {
+  for (const char * p = sScannedBuffer; p < sScannedEnd; p += scannedRecordSize(p)) {
+    const char * name = p + sizeof(Storage::record_size_t);
+    if (record == Storage::Record(name)) {
+      size_t offset = sizeof(Storage::record_size_t) + strlen(name) + 1;
+      return {.buffer = p + offset, .size = scannedRecordSize(p) - offset};
+    }
+  }
+  return {.buffer = nullptr, .size = 0};
+}
+
+QUIZ_CASE(ion_benchmark_storage) {
+  Storage * storage = Storage::sharedStorage();
+  constexpr int k_numberOfRecords = 64;
+  const char * extensions[] = {"py", "exp", "func", "seq"};
+  char names[k_numberOfRecords][16];
+  char value[64] = {0};
+  for (int i = 0; i < k_numberOfRecords; i++) {
+    snprintf(names[i], sizeof(names[i]), "record%d.%s", i, extensions[i%4]);
+    Storage::Record::ErrorStatus error = storage->createRecord(names[i], value, sizeof(value));
+    assert(error == Storage::Record::ErrorStatus::None);
+    (void)error;
+    addScannedRecord(names[i], value, sizeof(value));
+  }
+  constexpr int k_numberOfLookups = 20000;
+  size_t sum = 0;
+  int i = 0;
+  // The last records are the furthest in the buffer
+  double scan = quiz_benchmark(k_numberOfLookups, [&]() {
+      sum += scannedValue(scannedRecordNamed(names[k_numberOfRecords - 1 - (i++)%16])).size;
+    });
+  i = 0;
+  double indexed = quiz_benchmark(k_numberOfLookups, [&]() {
+      sum += storage->recordNamed(names[k_numberOfRecords - 1 - (i++)%16]).value().size;
+    });
+  quiz_benchmark_print("recordNamed + value", scan, indexed);
+  for (int i = 0; i < k_numberOfRecords; i++) {
+    storage->recordNamed(names[i]).destroy();
+  }
+  sScannedEnd = sScannedBuffer;
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "(checksum %zu)", sum);
+  quiz_print(buffer);
+}
@@ -8,3 +8,34 @@ QUIZ_CASE(ion_crc32) {
   quiz_assert(Ion::crc32(input, 2) == 0x72EAD3FB);
 }
 
+/* Reference bit-at-a-time implementation */
+static uint32_t bitwise_crc32(const uint32_t * data, size_t length) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < length; i++) {
+    for (int byte = 3; byte >= 0; byte--) {
+      crc ^= ((data[i] >> (8*byte)) & 0xFF) << 24;
+      for (int bit = 0; bit < 8; bit++) {
+        crc = crc & 0x80000000 ? ((crc<<1)^0x04C11DB7) : (crc << 1);
+      }
+    }
+  }
+  return crc;
+}
+
+QUIZ_CASE(ion_crc32_matches_bitwise_crc32) {
+  constexpr size_t k_length = 64;
+  uint32_t input[k_length];
+  uint32_t x = 0x12345678;
+  for (size_t i = 0; i < k_length; i++) {
+    // Xorshift, to cover every byte value
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    input[i] = x;
+  }
+  input[0] = 0;
+  input[1] = 0xFFFFFFFF;
+  for (size_t length = 0; length <= k_length; length++) {
+    quiz_assert(Ion::crc32(input, length) == bitwise_crc32(input, length));
+  }
+}
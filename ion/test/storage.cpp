@@ -0,0 +1,117 @@
+#include <quiz.h>
+#include <ion.h>
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace Ion;
+
+static void recordName(char * buffer, size_t bufferSize, const char * prefix, int i) {
+  snprintf(buffer, bufferSize, "%s%d.test", prefix, i);
+}
+
+static void assert_records_are_found(const char * prefix, int numberOfRecords) {
+  Storage * storage = Storage::sharedStorage();
+  char name[24];
+  for (int i = 0; i < numberOfRecords; i++) {
+    recordName(name, sizeof(name), prefix, i);
+    Storage::Record r = storage->recordNamed(name);
+    quiz_assert(!r.isNull());
+    quiz_assert(strcmp(r.name(), name) == 0);
+    Storage::Record::Data d = r.value();
+    quiz_assert(d.size == sizeof(int));
+    quiz_assert(*static_cast<const int *>(d.buffer) == i);
+  }
+}
+
+static void destroy_records(const char * prefix, int numberOfRecords) {
+  Storage * storage = Storage::sharedStorage();
+  char name[24];
+  for (int i = 0; i < numberOfRecords; i++) {
+    recordName(name, sizeof(name), prefix, i);
+    storage->recordNamed(name).destroy();
+    quiz_assert(storage->recordNamed(name).isNull());
+  }
+}
+
+static void create_records(const char * prefix, int numberOfRecords) {
+  Storage * storage = Storage::sharedStorage();
+  char name[24];
+  for (int i = 0; i < numberOfRecords; i++) {
+    recordName(name, sizeof(name), prefix, i);
+    quiz_assert(storage->createRecord(name, &i, sizeof(int)) == Storage::Record::ErrorStatus::None);
+  }
+}
+
+QUIZ_CASE(ion_storage_records) {
+  Storage * storage = Storage::sharedStorage();
+  size_t initialAvailableSize = storage->availableSize();
+  constexpr int n = 60;
+  create_records("r", n);
+  quiz_assert(storage->numberOfRecordsWithExtension("test") == n);
+  assert_records_are_found("r", n);
+  quiz_assert(storage->recordNamed("r60.test").isNull());
+  quiz_assert(storage->createRecord("r3.test", nullptr, 0) == Storage::Record::ErrorStatus::NameTaken);
+
+  // Grow and shrink records: the following records are moved
+  char value[100];
+  memset(value, 1, sizeof(value));
+  Storage::Record r = storage->recordNamed("r10.test");
+  quiz_assert(r.setValue({.buffer = value, .size = sizeof(value)}) == Storage::Record::ErrorStatus::None);
+  quiz_assert(r.value().size == sizeof(value));
+  int ten = 10;
+  quiz_assert(r.setValue({.buffer = &ten, .size = sizeof(int)}) == Storage::Record::ErrorStatus::None);
+  assert_records_are_found("r", n);
+
+  // Rename a record
+  r = storage->recordNamed("r20.test");
+  quiz_assert(r.setName("renamed.test") == Storage::Record::ErrorStatus::None);
+  quiz_assert(storage->recordNamed("r20.test").isNull());
+  r = storage->recordNamed("renamed.test");
+  quiz_assert(!r.isNull());
+  quiz_assert(*static_cast<const int *>(r.value().buffer) == 20);
+  quiz_assert(r.setName("r21.test") == Storage::Record::ErrorStatus::NameTaken);
+  quiz_assert(r.setName("r20.test") == Storage::Record::ErrorStatus::None);
+  assert_records_are_found("r", n);
+
+  // Destroy records in the middle of the buffer
+  storage->recordNamed("r0.test").destroy();
+  storage->recordNamed("r30.test").destroy();
+  quiz_assert(storage->recordNamed("r0.test").isNull());
+  quiz_assert(storage->recordNamed("r30.test").isNull());
+  quiz_assert(storage->numberOfRecordsWithExtension("test") == n-2);
+  int zero = 0;
+  int thirty = 30;
+  quiz_assert(storage->createRecord("r0.test", &zero, sizeof(int)) == Storage::Record::ErrorStatus::None);
+  quiz_assert(storage->createRecord("r30.test", &thirty, sizeof(int)) == Storage::Record::ErrorStatus::None);
+  assert_records_are_found("r", n);
+
+  // The index is rebuilt from the buffer
+  storage->rebuildIndex();
+  assert_records_are_found("r", n);
+
+  destroy_records("r", n);
+  quiz_assert(storage->numberOfRecordsWithExtension("test") == 0);
+  quiz_assert(storage->availableSize() == initialAvailableSize);
+}
+
+QUIZ_CASE(ion_storage_many_records) {
+  // More records than the index can hold
+  Storage * storage = Storage::sharedStorage();
+  size_t initialAvailableSize = storage->availableSize();
+  constexpr int n = 150;
+  create_records("m", n);
+  assert_records_are_found("m", n);
+  destroy_records("m", n/2);
+  assert_records_are_found("m", 0);
+  char name[24];
+  for (int i = n/2; i < n; i++) {
+    recordName(name, sizeof(name), "m", i);
+    Storage::Record r = storage->recordNamed(name);
+    quiz_assert(!r.isNull());
+    quiz_assert(*static_cast<const int *>(r.value().buffer) == i);
+    r.destroy();
+  }
+  quiz_assert(storage->numberOfRecordsWithExtension("test") == 0);
+  quiz_assert(storage->availableSize() == initialAvailableSize);
+}
@@ -2,10 +2,12 @@
 #define KANDINSKY_KANDINSKY_H
 
 #include <kandinsky/color.h>
+#include <kandinsky/compositor_context.h>
 #include <kandinsky/coordinate.h>
 #include <kandinsky/context.h>
 #include <kandinsky/framebuffer.h>
 #include <kandinsky/framebuffer_context.h>
+#include <kandinsky/glyph_cache.h>
 #include <kandinsky/ion_context.h>
 #include <kandinsky/point.h>
 #include <kandinsky/rect.h>
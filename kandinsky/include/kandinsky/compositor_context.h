@@ -0,0 +1,62 @@
+#ifndef KANDINSKY_COMPOSITOR_CONTEXT_H
+#define KANDINSKY_COMPOSITOR_CONTEXT_H
+
+#include <kandinsky/context.h>
+
+#ifndef KD_COMPOSITOR_TILE_SIZE
+#define KD_COMPOSITOR_TILE_SIZE 16
+#endif
+
+/* KDCompositorContext draws in a copy of the screen kept in RAM, which is
+ * split in square tiles of k_tileSize pixels. A tile is marked as changed when
+ * one of its pixels changes color, and flush pushes the changed tiles to the
+ * screen, a run of adjacent tiles of a row at a time. Overlapping views thus
+ * draw the same pixels several times in RAM only, and the screen is only sent
+ * what has changed since the last flush.
+ * The copy of the screen is as large as the screen: Escher only draws in it
+ * when it is built with ESCHER_COMPOSITOR=1, and the compositor is only linked
+ * then, or on host platforms to be tested.
+ * The frame statistics cost a bitmap of the screen and a bit test per drawn
+ * pixel: they are only kept with KD_COMPOSITOR_STATISTICS=1, when they are
+ * logged or tested. */
+
+class KDCompositorContext : public KDContext {
+public:
+  constexpr static KDCoordinate k_tileSize = KD_COMPOSITOR_TILE_SIZE;
+
+#if KD_COMPOSITOR_STATISTICS
+  struct FrameStatistics {
+    int numberOfPixelsDrawn;
+    // Pixels drawn at least once: the overdraw is the ratio of both counts
+    int numberOfDistinctPixelsDrawn;
+    int numberOfPushedTiles;
+    int numberOfPushedBytes;
+  };
+#endif
+
+  static KDCompositorContext * sharedContext();
+  // Push the changed tiles to the screen
+  void flush();
+  /* The screen has been drawn without the compositor: push it again at the
+   * next flush. Drawing in KDIonContext invalidates the drawn rect when Escher
+   * draws in the compositor, but whatever calls Ion::Display directly or turns
+   * the screen off must call invalidate, or redraw the window with force. */
+  void invalidate();
+  void invalidate(KDRect rect);
+#if KD_COMPOSITOR_STATISTICS
+  // Statistics of the frame ended by the last flush
+  const FrameStatistics & lastFrameStatistics() const { return m_lastFrameStatistics; }
+#endif
+private:
+  KDCompositorContext();
+  void pushRect(KDRect rect, const KDColor * pixels) override;
+  void pushRectUniform(KDRect rect, KDColor color) override;
+  void pullRect(KDRect rect, KDColor * pixels) override;
+#if KD_COMPOSITOR_STATISTICS
+  void markAsDrawn(KDCoordinate x, KDCoordinate y, KDCoordinate width);
+  FrameStatistics m_frameStatistics;
+  FrameStatistics m_lastFrameStatistics;
+#endif
+};
+
+#endif
@@ -13,6 +13,9 @@ public:
   // Pixel manipulation
   void setPixel(KDPoint p, KDColor c);
   KDColor getPixel(KDPoint p);
+  /* Pixels of the rect, row after row. Those outside the clipping rect are
+   * left untouched. */
+  void getPixels(KDRect rect, KDColor * pixels);
 
   // Text
   KDPoint drawString(const char * text, KDPoint p, KDText::FontSize size = KDText::FontSize::Large, KDColor textColor = KDColorBlack, KDColor backgroundColor = KDColorWhite, int maxLength = -1);
@@ -34,7 +37,7 @@ protected:
 private:
   KDRect absoluteFillRect(KDRect rect);
   KDPoint writeString(const char * text, KDPoint p, KDText::FontSize size, KDColor textColor, KDColor backgroundColor, int maxLength, bool transparentBackground);
-  void writeChar(char character, KDPoint p, KDText::FontSize size, KDColor textColor, KDColor backgroundColor, bool transparentBackground);
+  void writeGlyphRun(const char * glyphs, int numberOfGlyphs, KDPoint p, KDText::FontSize size, KDColor textColor, KDColor backgroundColor, bool transparentBackground);
   KDPoint m_origin;
   KDRect m_clippingRect;
 };
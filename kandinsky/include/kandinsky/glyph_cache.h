@@ -0,0 +1,33 @@
+#ifndef KANDINSKY_GLYPH_CACHE_H
+#define KANDINSKY_GLYPH_CACHE_H
+
+#include <kandinsky/color.h>
+#include <kandinsky/text.h>
+#include <stdint.h>
+
+/* KDGlyphCache keeps the last glyphs blended on an opaque background. The UI
+ * draws text with a handful of color pairs (black on white, black on the
+ * grays of table cells, white on a highlighted cell), so most glyphs are
+ * found in the cache and drawing them is a copy of their rows. The least
+ * recently used glyph of a font size is evicted when its entries are full.
+ * A small glyph takes 196 bytes and a large one 360 bytes: with the keys and
+ * times of use, the cache takes 6.2 KB of RAM. The small entries hold the
+ * digits, signs and letters of a table of values in one color pair. */
+
+class KDGlyphCache {
+public:
+  constexpr static int k_numberOfSmallGlyphs = 16;
+  constexpr static int k_numberOfLargeGlyphs = 8;
+  /* Return the pixels of the glyph of c, blended from backgroundColor to
+   * textColor. They are laid out row by row, KDText::charSize(size) wide, and
+   * stay valid until the next call. */
+  static const KDColor * glyph(char c, KDText::FontSize size, KDColor textColor, KDColor backgroundColor);
+  static void clear();
+
+  // Statistics
+  static int numberOfHits();
+  static int numberOfMisses();
+  static void resetStatistics();
+};
+
+#endif
@@ -0,0 +1,166 @@
+#include <kandinsky/compositor_context.h>
+#include <ion.h>
+#include <string.h>
+
+constexpr static int k_numberOfPixels = Ion::Display::Width*Ion::Display::Height;
+
+constexpr static int k_tileSize = KDCompositorContext::k_tileSize;
+constexpr static int k_numberOfTileColumns = (Ion::Display::Width+k_tileSize-1)/k_tileSize;
+constexpr static int k_numberOfTileRows = (Ion::Display::Height+k_tileSize-1)/k_tileSize;
+
+// One bit per tile of a row, set when the tile has changed since the last flush
+typedef uint64_t TileRow;
+static_assert(k_numberOfTileColumns <= 64, "A row of tiles must fit in a TileRow");
+
+static KDColor sPixels[k_numberOfPixels];
+static TileRow sChangedTiles[k_numberOfTileRows];
+#if KD_COMPOSITOR_STATISTICS
+static_assert(k_numberOfPixels % 32 == 0, "The drawn pixels bitmap must be made of whole words");
+// Pixels drawn since the last flush, one bit each
+static uint32_t sDrawnPixels[k_numberOfPixels/32];
+#endif
+// The rows of a run of tiles narrower than the screen are gathered here
+static KDColor sRunBuffer[Ion::Display::Width*KDCompositorContext::k_tileSize];
+
+#if KD_COMPOSITOR_STATISTICS
+constexpr static KDCompositorContext::FrameStatistics k_emptyFrameStatistics = {0, 0, 0, 0};
+#endif
+
+KDCompositorContext * KDCompositorContext::sharedContext() {
+  static KDCompositorContext context;
+  return &context;
+}
+
+KDCompositorContext::KDCompositorContext() :
+  KDContext(KDPointZero, KDRect(0, 0, Ion::Display::Width, Ion::Display::Height))
+#if KD_COMPOSITOR_STATISTICS
+  , m_frameStatistics(k_emptyFrameStatistics),
+  m_lastFrameStatistics(k_emptyFrameStatistics)
+#endif
+{
+  // Nothing is known of what the screen shows
+  invalidate();
+}
+
+void KDCompositorContext::flush() {
+  for (int r = 0; r < k_numberOfTileRows; r++) {
+    TileRow changedTiles = sChangedTiles[r];
+    while (changedTiles != 0) {
+      int first = __builtin_ctzll(changedTiles);
+      int last = first;
+      while (last + 1 < k_numberOfTileColumns && ((changedTiles >> (last + 1)) & 1)) {
+        last++;
+      }
+      KDRect runRect = KDRect(first*k_tileSize, r*k_tileSize, (last + 1 - first)*k_tileSize, k_tileSize)
+        .intersectedWith(KDRect(0, 0, Ion::Display::Width, Ion::Display::Height));
+      const KDColor * runPixels = sPixels + runRect.x() + runRect.y()*Ion::Display::Width;
+      if (runRect.width() < Ion::Display::Width) {
+        for (KDCoordinate j = 0; j < runRect.height(); j++) {
+          memcpy(sRunBuffer + j*runRect.width(), runPixels + j*Ion::Display::Width, runRect.width()*sizeof(KDColor));
+        }
+        runPixels = sRunBuffer;
+      }
+      Ion::Display::pushRect(runRect, runPixels);
+#if KD_COMPOSITOR_STATISTICS
+      m_frameStatistics.numberOfPushedTiles += last + 1 - first;
+      m_frameStatistics.numberOfPushedBytes += runRect.width()*runRect.height()*sizeof(KDColor);
+#endif
+      // Clear the bits of the tiles from first to last
+      changedTiles &= ~(((TileRow)2 << last) - ((TileRow)1 << first));
+    }
+    sChangedTiles[r] = 0;
+  }
+#if KD_COMPOSITOR_STATISTICS
+  m_lastFrameStatistics = m_frameStatistics;
+  m_frameStatistics = k_emptyFrameStatistics;
+  memset(sDrawnPixels, 0, sizeof(sDrawnPixels));
+#endif
+}
+
+void KDCompositorContext::invalidate() {
+  invalidate(KDRect(0, 0, Ion::Display::Width, Ion::Display::Height));
+}
+
+void KDCompositorContext::invalidate(KDRect rect) {
+  rect = rect.intersectedWith(KDRect(0, 0, Ion::Display::Width, Ion::Display::Height));
+  if (rect.isEmpty()) {
+    return;
+  }
+  int firstColumn = rect.x()/k_tileSize;
+  int lastColumn = rect.right()/k_tileSize;
+  // The bits of the tiles from firstColumn to lastColumn
+  TileRow tiles = ((TileRow)2 << lastColumn) - ((TileRow)1 << firstColumn);
+  for (int r = rect.y()/k_tileSize; r <= rect.bottom()/k_tileSize; r++) {
+    sChangedTiles[r] |= tiles;
+  }
+}
+
+void KDCompositorContext::pushRect(KDRect rect, const KDColor * pixels) {
+#if KD_COMPOSITOR_STATISTICS
+  m_frameStatistics.numberOfPixelsDrawn += rect.width()*rect.height();
+#endif
+  for (KDCoordinate j = 0; j < rect.height(); j++) {
+    KDCoordinate y = rect.y() + j;
+    KDColor * line = sPixels + y*Ion::Display::Width;
+    const KDColor * source = pixels + j*rect.width();
+    // The row is compared and copied a tile at a time
+    KDCoordinate x = rect.x();
+    while (x <= rect.right()) {
+      KDCoordinate tileEnd = (x/k_tileSize + 1)*k_tileSize;
+      KDCoordinate width = (tileEnd <= rect.right() ? tileEnd : rect.right() + 1) - x;
+      if (memcmp(line + x, source + x - rect.x(), width*sizeof(KDColor)) != 0) {
+        memcpy(line + x, source + x - rect.x(), width*sizeof(KDColor));
+        sChangedTiles[y/k_tileSize] |= (TileRow)1 << (x/k_tileSize);
+      }
+      x += width;
+    }
+#if KD_COMPOSITOR_STATISTICS
+    markAsDrawn(rect.x(), y, rect.width());
+#endif
+  }
+}
+
+void KDCompositorContext::pushRectUniform(KDRect rect, KDColor color) {
+#if KD_COMPOSITOR_STATISTICS
+  m_frameStatistics.numberOfPixelsDrawn += rect.width()*rect.height();
+#endif
+  for (KDCoordinate j = 0; j < rect.height(); j++) {
+    KDCoordinate y = rect.y() + j;
+    KDColor * line = sPixels + y*Ion::Display::Width;
+    KDCoordinate x = rect.x();
+    while (x <= rect.right()) {
+      KDCoordinate tileEnd = (x/k_tileSize + 1)*k_tileSize;
+      KDCoordinate width = (tileEnd <= rect.right() ? tileEnd : rect.right() + 1) - x;
+      bool changed = false;
+      for (KDCoordinate i = x; i < x + width; i++) {
+        changed = changed || line[i] != color;
+        line[i] = color;
+      }
+      if (changed) {
+        sChangedTiles[y/k_tileSize] |= (TileRow)1 << (x/k_tileSize);
+      }
+      x += width;
+    }
+#if KD_COMPOSITOR_STATISTICS
+    markAsDrawn(rect.x(), y, rect.width());
+#endif
+  }
+}
+
+void KDCompositorContext::pullRect(KDRect rect, KDColor * pixels) {
+  for (KDCoordinate j = 0; j < rect.height(); j++) {
+    memcpy(pixels + j*rect.width(), sPixels + rect.x() + (rect.y() + j)*Ion::Display::Width, rect.width()*sizeof(KDColor));
+  }
+}
+
+#if KD_COMPOSITOR_STATISTICS
+void KDCompositorContext::markAsDrawn(KDCoordinate x, KDCoordinate y, KDCoordinate width) {
+  for (int index = x + y*Ion::Display::Width; index < x + width + y*Ion::Display::Width; index++) {
+    uint32_t bit = (uint32_t)1 << (index % 32);
+    if ((sDrawnPixels[index/32] & bit) == 0) {
+      sDrawnPixels[index/32] |= bit;
+      m_frameStatistics.numberOfDistinctPixelsDrawn++;
+    }
+  }
+}
+#endif
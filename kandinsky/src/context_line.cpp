@@ -22,6 +22,10 @@ void KDContext::drawLine(KDPoint p1, KDPoint p2, KDColor c) {
   assert(right.x() >= left.x());
   assert(bottom.y() >= top.y());
 
+  if (absoluteFillRect(KDRect(left.x(), top.y(), right.x() - left.x() + 1, bottom.y() - top.y() + 1)).isEmpty()) {
+    return;
+  }
+
   KDCoordinate deltaX = 2*(right.x() - left.x());
   KDCoordinate deltaY = 2*(bottom.y() - top.y());
 
@@ -46,14 +50,27 @@ void KDContext::drawLine(KDPoint p1, KDPoint p2, KDColor c) {
     conditionalTranslate = KDPoint((bottom.x() >= top.x() ? 1 : -1), 0);
   }
 
+  /* Pixels are not drawn one by one: the consecutive pixels which only differ
+   * along the scan axis make a run, which is filled at once. A horizontal or
+   * vertical line is a single run, and a line of slope 1/n has runs of n
+   * pixels. */
+  bool horizontalRuns = deltaX >= deltaY;
+  KDPoint runStart = p;
+  KDCoordinate runLength = 0;
   KDCoordinate scanCounter = 0;
   while (scanCounter++ < scanLength) {
-    setPixel(p, c);
+    runLength++;
     p = p.translatedBy(alwaysTranslate);
     error = error - minusError;
     if (error <= 0) {
+      fillRect(horizontalRuns ? KDRect(runStart, runLength, 1) : KDRect(runStart, 1, runLength), c);
       p = p.translatedBy(conditionalTranslate);
       error = error + plusError;
+      runStart = p;
+      runLength = 0;
     }
   }
+  if (runLength > 0) {
+    fillRect(horizontalRuns ? KDRect(runStart, runLength, 1) : KDRect(runStart, 1, runLength), c);
+  }
 }
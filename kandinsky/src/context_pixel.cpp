@@ -16,3 +16,20 @@ KDColor KDContext::getPixel(KDPoint p) {
   }
   return KDColorBlack;
 }
+
+void KDContext::getPixels(KDRect rect, KDColor * pixels) {
+  KDRect absoluteRect = absoluteFillRect(rect);
+  if (absoluteRect.isEmpty()) {
+    return;
+  }
+  if (absoluteRect.width() == rect.width() && absoluteRect.height() == rect.height()) {
+    pullRect(absoluteRect, pixels);
+    return;
+  }
+  KDCoordinate startingI = absoluteRect.x() - rect.translatedBy(m_origin).x();
+  KDCoordinate startingJ = absoluteRect.y() - rect.translatedBy(m_origin).y();
+  for (KDCoordinate j=0; j<absoluteRect.height(); j++) {
+    KDRect absoluteRow = KDRect(absoluteRect.x(), absoluteRect.y()+j, absoluteRect.width(), 1);
+    pullRect(absoluteRow, pixels+startingI+rect.width()*(startingJ+j));
+  }
+}
@@ -1,10 +1,17 @@
 #include <kandinsky/context.h>
+#include <kandinsky/glyph_cache.h>
 #include <kandinsky/text.h>
 #include "small_font.h"
 #include "large_font.h"
+#include <assert.h>
+#include <string.h>
 
-KDColor smallCharacterBuffer[BITMAP_SmallFont_CHARACTER_WIDTH*BITMAP_SmallFont_CHARACTER_HEIGHT];
-KDColor largeCharacterBuffer[BITMAP_LargeFont_CHARACTER_WIDTH*BITMAP_LargeFont_CHARACTER_HEIGHT];
+/* A run of glyphs is rasterized in this buffer, then pushed at once: each
+ * pushRect sets up a new window on the LCD, which costs as much as pushing
+ * many pixels. The buffer takes 1080 bytes and holds 3 large glyphs or 5 small
+ * ones: longer runs are split in several pushRects. */
+constexpr static int k_runBufferSize = 3*BITMAP_LargeFont_CHARACTER_WIDTH*BITMAP_LargeFont_CHARACTER_HEIGHT;
+static KDColor sRunBuffer[k_runBufferSize];
 
 KDPoint KDContext::drawString(const char * text, KDPoint p, KDText::FontSize size, KDColor textColor, KDColor backgroundColor, int maxLength) {
   return writeString(text, p, size, textColor, backgroundColor, maxLength, false);
@@ -18,53 +25,76 @@ KDPoint KDContext::writeString(const char * text, KDPoint p, KDText::FontSize si
   KDPoint position = p;
   int characterWidth = size == KDText::FontSize::Large ? BITMAP_LargeFont_CHARACTER_WIDTH : BITMAP_SmallFont_CHARACTER_WIDTH;
   int characterHeight = size == KDText::FontSize::Large ? BITMAP_LargeFont_CHARACTER_HEIGHT: BITMAP_SmallFont_CHARACTER_HEIGHT;
-  KDPoint characterSize(characterWidth, 0);
+  int maxNumberOfGlyphsInRun = k_runBufferSize/(characterWidth*characterHeight);
 
   const char * end = text+maxLength;
   while(*text != 0 && text != end) {
-    writeChar(*text, position, size, textColor, backgroundColor, transparentBackground);
     if (*text == '\n') {
       position = KDPoint(0, position.y()+characterHeight);
-    } else if (*text == '\t') {
+      text++;
+      continue;
+    }
+    if (*text == '\t') {
       position = position.translatedBy(KDPoint(KDText::k_tabCharacterWidth*characterWidth, 0));
-    } else {
-      position = position.translatedBy(characterSize);
+      text++;
+      continue;
+    }
+    // The run goes on until the end of the line or a tabulation
+    const char * run = text;
+    while (*text != 0 && text != end && *text != '\n' && *text != '\t' && text - run < maxNumberOfGlyphsInRun) {
+      text++;
     }
-    text++;
+    writeGlyphRun(run, text - run, position, size, textColor, backgroundColor, transparentBackground);
+    position = position.translatedBy(KDPoint((text - run)*characterWidth, 0));
   }
   return position;
 }
 
-void KDContext::writeChar(char character, KDPoint p, KDText::FontSize size, KDColor textColor, KDColor backgroundColor, bool transparentBackground) {
-  if (character == '\n' || character == '\t') {
-    return;
-  }
+void KDContext::writeGlyphRun(const char * glyphs, int numberOfGlyphs, KDPoint p, KDText::FontSize size, KDColor textColor, KDColor backgroundColor, bool transparentBackground) {
   char firstCharacter = size == KDText::FontSize::Large ? BITMAP_LargeFont_FIRST_CHARACTER : BITMAP_SmallFont_FIRST_CHARACTER;
   int characterHeight = size == KDText::FontSize::Large ? BITMAP_LargeFont_CHARACTER_HEIGHT : BITMAP_SmallFont_CHARACTER_HEIGHT;
   int characterWidth = size == KDText::FontSize::Large ? BITMAP_LargeFont_CHARACTER_WIDTH : BITMAP_SmallFont_CHARACTER_WIDTH;
+  assert(numberOfGlyphs > 0 && numberOfGlyphs*characterWidth*characterHeight <= k_runBufferSize);
 
-  KDColor * characterBuffer = size == KDText::FontSize::Large ? largeCharacterBuffer : smallCharacterBuffer;
-
-  KDRect absoluteRect = absoluteFillRect(KDRect(p, characterWidth, characterHeight));
+  KDRect absoluteRect = absoluteFillRect(KDRect(p, numberOfGlyphs*characterWidth, characterHeight));
+  if (absoluteRect.isEmpty()) {
+    return;
+  }
   if (transparentBackground) {
-    pullRect(absoluteRect, characterBuffer);
+    pullRect(absoluteRect, sRunBuffer);
   }
+  /* The clipped rect starts at column startingI and row startingJ of the run:
+   * only the glyphs it crosses are rasterized, and only their visible
+   * columns. */
   KDCoordinate startingI = m_clippingRect.x() - p.translatedBy(m_origin).x();
   KDCoordinate startingJ = m_clippingRect.y() - p.translatedBy(m_origin).y();
   startingI = startingI < 0 ? 0 : startingI;
   startingJ = startingJ < 0 ? 0 : startingJ;
+  KDCoordinate endingI = startingI + absoluteRect.width();
 
-  for (KDCoordinate j=0; j<absoluteRect.height(); j++) {
-    for (KDCoordinate i=0; i<absoluteRect.width(); i++) {
-      KDColor * currentPixelAdress = characterBuffer + i + absoluteRect.width()*j;         uint8_t intensity = 0;
-      if (size == KDText::FontSize::Large) {
-        intensity = bitmapLargeFont[(uint8_t)character-(uint8_t)firstCharacter][j + startingJ][i +startingI];
-      } else {
-       intensity = bitmapSmallFont[(uint8_t)character-(uint8_t)firstCharacter][j + startingJ][i +startingI];
+  for (int g = startingI/characterWidth; g*characterWidth < endingI; g++) {
+    int glyphStartingI = g*characterWidth;
+    int firstColumn = startingI > glyphStartingI ? startingI - glyphStartingI : 0;
+    int lastColumn = endingI < glyphStartingI + characterWidth ? endingI - glyphStartingI : characterWidth;
+    if (!transparentBackground) {
+      // Copy the rows of the glyph, blended once and for all by the cache
+      const KDColor * glyphPixels = KDGlyphCache::glyph(glyphs[g], size, textColor, backgroundColor);
+      for (KDCoordinate j=0; j<absoluteRect.height(); j++) {
+        memcpy(sRunBuffer + glyphStartingI - startingI + firstColumn + absoluteRect.width()*j,
+            glyphPixels + firstColumn + characterWidth*(j + startingJ),
+            (lastColumn - firstColumn)*sizeof(KDColor));
+      }
+      continue;
+    }
+    int glyphIndex = (uint8_t)glyphs[g]-(uint8_t)firstCharacter;
+    const uint8_t * glyphBitmap = size == KDText::FontSize::Large ? &bitmapLargeFont[glyphIndex][0][0] : &bitmapSmallFont[glyphIndex][0][0];
+    for (KDCoordinate j=0; j<absoluteRect.height(); j++) {
+      const uint8_t * intensities = glyphBitmap + characterWidth*(j + startingJ);
+      KDColor * rowPixels = sRunBuffer + glyphStartingI - startingI + absoluteRect.width()*j;
+      for (int i = firstColumn; i < lastColumn; i++) {
+        rowPixels[i] = KDColor::blend(textColor, rowPixels[i], intensities[i]);
       }
-      KDColor backColor = transparentBackground ? *currentPixelAdress : backgroundColor;
-      *currentPixelAdress = KDColor::blend(textColor, backColor, intensity);
     }
   }
-  pushRect(absoluteRect, characterBuffer);
+  pushRect(absoluteRect, sRunBuffer);
 }
@@ -0,0 +1,86 @@
+#include <kandinsky/glyph_cache.h>
+#include "small_font.h"
+#include "large_font.h"
+
+/* The key of a glyph packs its colors and its character, with a bit that
+ * tells the entry is used: the zero key is that of an unused entry. Each font
+ * size has its own entries, so the font size is not part of the key. */
+typedef uint64_t GlyphKey;
+constexpr static GlyphKey k_usedEntryBit = (GlyphKey)1 << 48;
+
+static inline GlyphKey keyOfGlyph(char c, KDColor textColor, KDColor backgroundColor) {
+  return k_usedEntryBit | (GlyphKey)(uint16_t)textColor << 32 | (GlyphKey)(uint16_t)backgroundColor << 16 | (uint8_t)c;
+}
+
+static uint32_t sTime = 0;
+static int sNumberOfHits = 0;
+static int sNumberOfMisses = 0;
+
+/* The glyphs of a font size, each entry being exactly as large as a glyph of
+ * that size. */
+template<int Width, int Height, int NumberOfGlyphs>
+class GlyphEntries {
+public:
+  const KDColor * glyph(char c, const uint8_t * intensities, KDColor textColor, KDColor backgroundColor) {
+    GlyphKey key = keyOfGlyph(c, textColor, backgroundColor);
+    int leastRecentlyUsed = 0;
+    for (int i = 0; i < NumberOfGlyphs; i++) {
+      if (m_keys[i] == key) {
+        sNumberOfHits++;
+        m_lastUses[i] = sTime;
+        return m_pixels[i];
+      }
+      if (m_lastUses[i] < m_lastUses[leastRecentlyUsed]) {
+        leastRecentlyUsed = i;
+      }
+    }
+    sNumberOfMisses++;
+    KDColor * pixels = m_pixels[leastRecentlyUsed];
+    for (int i = 0; i < Width*Height; i++) {
+      pixels[i] = KDColor::blend(textColor, backgroundColor, intensities[i]);
+    }
+    m_keys[leastRecentlyUsed] = key;
+    m_lastUses[leastRecentlyUsed] = sTime;
+    return pixels;
+  }
+  void clear() {
+    for (int i = 0; i < NumberOfGlyphs; i++) {
+      m_keys[i] = 0;
+      m_lastUses[i] = 0;
+    }
+  }
+private:
+  GlyphKey m_keys[NumberOfGlyphs];
+  // Time of the last use of each entry, the least recently used one is evicted
+  uint32_t m_lastUses[NumberOfGlyphs];
+  KDColor m_pixels[NumberOfGlyphs][Width*Height];
+};
+
+static GlyphEntries<BITMAP_SmallFont_CHARACTER_WIDTH, BITMAP_SmallFont_CHARACTER_HEIGHT, KDGlyphCache::k_numberOfSmallGlyphs> sSmallGlyphs;
+static GlyphEntries<BITMAP_LargeFont_CHARACTER_WIDTH, BITMAP_LargeFont_CHARACTER_HEIGHT, KDGlyphCache::k_numberOfLargeGlyphs> sLargeGlyphs;
+
+const KDColor * KDGlyphCache::glyph(char c, KDText::FontSize size, KDColor textColor, KDColor backgroundColor) {
+  sTime++;
+  if (size == KDText::FontSize::Large) {
+    return sLargeGlyphs.glyph(c, &bitmapLargeFont[(uint8_t)c-(uint8_t)BITMAP_LargeFont_FIRST_CHARACTER][0][0], textColor, backgroundColor);
+  }
+  return sSmallGlyphs.glyph(c, &bitmapSmallFont[(uint8_t)c-(uint8_t)BITMAP_SmallFont_FIRST_CHARACTER][0][0], textColor, backgroundColor);
+}
+
+void KDGlyphCache::clear() {
+  sSmallGlyphs.clear();
+  sLargeGlyphs.clear();
+}
+
+int KDGlyphCache::numberOfHits() {
+  return sNumberOfHits;
+}
+
+int KDGlyphCache::numberOfMisses() {
+  return sNumberOfMisses;
+}
+
+void KDGlyphCache::resetStatistics() {
+  sNumberOfHits = 0;
+  sNumberOfMisses = 0;
+}
@@ -1,6 +1,12 @@
 #include <kandinsky/ion_context.h>
+#if ESCHER_COMPOSITOR
+#include <kandinsky/compositor_context.h>
+#endif
 #include <ion.h>
 
+/* When Escher draws in the compositor, what is drawn here is overwritten by
+ * the compositor's copy of the screen at its next flush. */
+
 KDIonContext * KDIonContext::sharedContext() {
   static KDIonContext context;
   return &context;
@@ -13,10 +19,16 @@ KDContext(KDPointZero,
 }
 
 void KDIonContext::pushRect(KDRect rect, const KDColor * pixels) {
+#if ESCHER_COMPOSITOR
+  KDCompositorContext::sharedContext()->invalidate(rect);
+#endif
   Ion::Display::pushRect(rect, pixels);
 }
 
 void KDIonContext::pushRectUniform(KDRect rect, KDColor color) {
+#if ESCHER_COMPOSITOR
+  KDCompositorContext::sharedContext()->invalidate(rect);
+#endif
   Ion::Display::pushRectUniform(rect, color);
 }
 
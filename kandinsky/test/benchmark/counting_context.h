@@ -0,0 +1,29 @@
+#ifndef KANDINSKY_TEST_BENCHMARK_COUNTING_CONTEXT_H
+#define KANDINSKY_TEST_BENCHMARK_COUNTING_CONTEXT_H
+
+#include <kandinsky.h>
+
+/* A frame buffer context which counts the rects pushed to the display: on the
+ * device, each of them sets up a window on the LCD. */
+class CountingContext : public KDFrameBufferContext {
+public:
+  CountingContext(KDFrameBuffer * frameBuffer) :
+    KDFrameBufferContext(frameBuffer),
+    m_numberOfPushRects(0)
+  {}
+  int numberOfPushRects() const { return m_numberOfPushRects; }
+  void resetNumberOfPushRects() { m_numberOfPushRects = 0; }
+protected:
+  void pushRect(KDRect rect, const KDColor * pixels) override {
+    m_numberOfPushRects++;
+    KDFrameBufferContext::pushRect(rect, pixels);
+  }
+  void pushRectUniform(KDRect rect, KDColor color) override {
+    m_numberOfPushRects++;
+    KDFrameBufferContext::pushRectUniform(rect, color);
+  }
+private:
+  int m_numberOfPushRects;
+};
+
+#endif
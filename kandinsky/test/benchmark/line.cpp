@@ -0,0 +1,35 @@
+#include <quiz_benchmark.h>
+#include <kandinsky.h>
+#include <ion.h>
+#include <stdio.h>
+#include "counting_context.h"
+
+// A frame of a graph: a grid, the axes and a polyline of the curve
+static void drawGraph(KDContext * context) {
+  for (int x = 0; x < Ion::Display::Width; x += 20) {
+    context->drawLine(KDPoint(x, 0), KDPoint(x, Ion::Display::Height), KDColor::RGB24(0xEEEEEE));
+  }
+  for (int y = 0; y < Ion::Display::Height; y += 20) {
+    context->drawLine(KDPoint(0, y), KDPoint(Ion::Display::Width, y), KDColor::RGB24(0xEEEEEE));
+  }
+  context->drawLine(KDPoint(0, 120), KDPoint(Ion::Display::Width, 120), KDColorBlack);
+  context->drawLine(KDPoint(160, 0), KDPoint(160, Ion::Display::Height), KDColorBlack);
+  for (int x = 0; x < Ion::Display::Width; x += 8) {
+    context->drawLine(KDPoint(x, 120 + (x*x)/(4*Ion::Display::Width) - 40), KDPoint(x+8, 120 + ((x+8)*(x+8))/(4*Ion::Display::Width) - 40), KDColorRed);
+  }
+}
+
+QUIZ_CASE(kandinsky_benchmark_line) {
+  static KDColor pixels[Ion::Display::Width*Ion::Display::Height];
+  KDFrameBuffer frameBuffer(pixels, KDSize(Ion::Display::Width, Ion::Display::Height));
+  CountingContext context(&frameBuffer);
+
+  drawGraph(&context);
+  char buffer[128];
+  snprintf(buffer, sizeof(buffer), "pushRects per graph frame: %d", context.numberOfPushRects());
+  quiz_print(buffer);
+  snprintf(buffer, sizeof(buffer), "graph frame: %.0f ns", quiz_benchmark(200, [&]() {
+      drawGraph(&context);
+    }));
+  quiz_print(buffer);
+}
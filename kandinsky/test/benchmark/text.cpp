@@ -0,0 +1,58 @@
+#include <quiz_benchmark.h>
+#include <kandinsky.h>
+#include <ion.h>
+#include <stdio.h>
+#include "counting_context.h"
+
+constexpr static int k_numberOfRows = 10;
+constexpr static int k_numberOfColumns = 3;
+static const char * sCells[k_numberOfColumns] = {"-1.234568E-5", "3.141593", "x^2+2*x-1"};
+
+// A frame of a table of values, one call to drawString per cell
+static void drawFrame(KDContext * context) {
+  for (int j = 0; j < k_numberOfRows; j++) {
+    for (int i = 0; i < k_numberOfColumns; i++) {
+      context->drawString(sCells[i], KDPoint(5+105*i, 5+22*j), KDText::FontSize::Small);
+    }
+  }
+}
+
+// The same frame, one call to drawString per character, as it was rendered
+static void drawFrameCharByChar(KDContext * context) {
+  for (int j = 0; j < k_numberOfRows; j++) {
+    for (int i = 0; i < k_numberOfColumns; i++) {
+      KDPoint position(5+105*i, 5+22*j);
+      for (const char * c = sCells[i]; *c != 0; c++) {
+        context->drawString(c, position, KDText::FontSize::Small, KDColorBlack, KDColorWhite, 1);
+        position = position.translatedBy(KDPoint(KDText::charSize(KDText::FontSize::Small).width(), 0));
+      }
+    }
+  }
+}
+
+QUIZ_CASE(kandinsky_benchmark_text) {
+  static KDColor pixels[Ion::Display::Width*Ion::Display::Height];
+  KDFrameBuffer frameBuffer(pixels, KDSize(Ion::Display::Width, Ion::Display::Height));
+  CountingContext context(&frameBuffer);
+
+  drawFrameCharByChar(&context);
+  int referenceNumberOfPushRects = context.numberOfPushRects();
+  context.resetNumberOfPushRects();
+  drawFrame(&context);
+  char buffer[128];
+  snprintf(buffer, sizeof(buffer), "pushRects per frame: %d -> %d", referenceNumberOfPushRects, context.numberOfPushRects());
+  quiz_print(buffer);
+
+  KDGlyphCache::resetStatistics();
+  drawFrame(&context);
+  snprintf(buffer, sizeof(buffer), "glyph cache per frame: %d hits, %d misses", KDGlyphCache::numberOfHits(), KDGlyphCache::numberOfMisses());
+  quiz_print(buffer);
+
+  double reference = quiz_benchmark(200, [&]() {
+      drawFrameCharByChar(&context);
+    });
+  double optimized = quiz_benchmark(200, [&]() {
+      drawFrame(&context);
+    });
+  quiz_benchmark_print("table of 30 cells", reference, optimized);
+}
@@ -0,0 +1,84 @@
+#include <quiz.h>
+#include <kandinsky.h>
+#include <ion.h>
+#include <assert.h>
+
+constexpr KDCoordinate k_tileSize = KDCompositorContext::k_tileSize;
+
+// Start from a flushed white screen, with no origin nor clipping
+static KDCompositorContext * whiteCompositorContext() {
+  KDCompositorContext * context = KDCompositorContext::sharedContext();
+  context->setOrigin(KDPointZero);
+  context->setClippingRect(KDRect(0, 0, Ion::Display::Width, Ion::Display::Height));
+  context->fillRect(KDRect(0, 0, Ion::Display::Width, Ion::Display::Height), KDColorWhite);
+  context->flush();
+  return context;
+}
+
+QUIZ_CASE(kandinsky_compositor_context_pushes_changed_tiles) {
+  KDCompositorContext * context = whiteCompositorContext();
+  // A rect inside a tile
+  context->fillRect(KDRect(k_tileSize+1, k_tileSize+1, 2, 2), KDColorRed);
+  context->flush();
+  KDCompositorContext::FrameStatistics statistics = context->lastFrameStatistics();
+  quiz_assert(statistics.numberOfPushedTiles == 1);
+  quiz_assert(statistics.numberOfPushedBytes == k_tileSize*k_tileSize*sizeof(KDColor));
+  // A rect across the corner of four tiles
+  context->fillRect(KDRect(2*k_tileSize-1, 2*k_tileSize-1, 2, 2), KDColorBlue);
+  context->flush();
+  quiz_assert(context->lastFrameStatistics().numberOfPushedTiles == 4);
+  // Drawing what the screen already shows does not change any tile
+  context->fillRect(KDRect(0, 0, Ion::Display::Width, k_tileSize), KDColorWhite);
+  context->fillRect(KDRect(k_tileSize+1, k_tileSize+1, 2, 2), KDColorRed);
+  KDColor pixels[3*3];
+  context->getPixels(KDRect(2*k_tileSize-1, 2*k_tileSize-1, 3, 3), pixels);
+  context->fillRectWithPixels(KDRect(2*k_tileSize-1, 2*k_tileSize-1, 3, 3), pixels, nullptr);
+  context->flush();
+  quiz_assert(context->lastFrameStatistics().numberOfPushedTiles == 0);
+  quiz_assert(context->lastFrameStatistics().numberOfPushedBytes == 0);
+}
+
+QUIZ_CASE(kandinsky_compositor_context_reads_drawn_pixels) {
+  KDCompositorContext * context = whiteCompositorContext();
+  context->setOrigin(KDPoint(10, 20));
+  context->drawString("a", KDPointZero, KDText::FontSize::Large, KDColorBlack, KDColorYellow);
+  quiz_assert(context->getPixel(KDPointZero) == KDColorYellow);
+  context->setPixel(KDPoint(1, 1), KDColorGreen);
+  quiz_assert(context->getPixel(KDPoint(1, 1)) == KDColorGreen);
+  context->setOrigin(KDPointZero);
+  quiz_assert(context->getPixel(KDPoint(11, 21)) == KDColorGreen);
+  context->flush();
+}
+
+QUIZ_CASE(kandinsky_compositor_context_counts_overdraw) {
+  KDCompositorContext * context = whiteCompositorContext();
+  context->fillRect(KDRect(0, 0, 10, 10), KDColorRed);
+  context->fillRect(KDRect(5, 0, 10, 10), KDColorBlue);
+  context->flush();
+  KDCompositorContext::FrameStatistics statistics = context->lastFrameStatistics();
+  quiz_assert(statistics.numberOfPixelsDrawn == 200);
+  quiz_assert(statistics.numberOfDistinctPixelsDrawn == 150);
+}
+
+QUIZ_CASE(kandinsky_compositor_context_invalidate) {
+  KDCompositorContext * context = whiteCompositorContext();
+  context->invalidate();
+  context->flush();
+  KDCompositorContext::FrameStatistics statistics = context->lastFrameStatistics();
+  quiz_assert(statistics.numberOfPushedTiles == ((Ion::Display::Width+k_tileSize-1)/k_tileSize)*((Ion::Display::Height+k_tileSize-1)/k_tileSize));
+  quiz_assert(statistics.numberOfPushedBytes == Ion::Display::Width*Ion::Display::Height*sizeof(KDColor));
+  quiz_assert(statistics.numberOfPixelsDrawn == 0);
+}
+
+QUIZ_CASE(kandinsky_compositor_context_invalidate_rect) {
+  KDCompositorContext * context = whiteCompositorContext();
+  context->invalidate(KDRect(k_tileSize-1, k_tileSize, 2, 1));
+  context->flush();
+  quiz_assert(context->lastFrameStatistics().numberOfPushedTiles == 2);
+#if ESCHER_COMPOSITOR
+  // What is drawn without the compositor is overwritten at the next flush
+  KDIonContext::sharedContext()->fillRect(KDRect(0, 0, 1, 1), KDColorRed);
+  context->flush();
+  quiz_assert(context->lastFrameStatistics().numberOfPushedTiles == 1);
+#endif
+}
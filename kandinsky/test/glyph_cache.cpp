@@ -0,0 +1,57 @@
+#include <quiz.h>
+#include <kandinsky.h>
+#include <assert.h>
+
+QUIZ_CASE(kandinsky_glyph_cache_blend) {
+  KDGlyphCache::clear();
+  const KDColor * pixels = KDGlyphCache::glyph('A', KDText::FontSize::Small, KDColorBlue, KDColorYellow);
+  for (int j = 0; j < BITMAP_SmallFont_CHARACTER_HEIGHT; j++) {
+    for (int i = 0; i < BITMAP_SmallFont_CHARACTER_WIDTH; i++) {
+      uint8_t intensity = bitmapSmallFont['A'-BITMAP_SmallFont_FIRST_CHARACTER][j][i];
+      quiz_assert(pixels[i+BITMAP_SmallFont_CHARACTER_WIDTH*j] == KDColor::blend(KDColorBlue, KDColorYellow, intensity));
+    }
+  }
+}
+
+QUIZ_CASE(kandinsky_glyph_cache_hits) {
+  KDGlyphCache::clear();
+  KDGlyphCache::resetStatistics();
+  const KDColor * a = KDGlyphCache::glyph('a', KDText::FontSize::Large, KDColorBlack, KDColorWhite);
+  quiz_assert(KDGlyphCache::glyph('a', KDText::FontSize::Large, KDColorBlack, KDColorWhite) == a);
+  // Any other font size or color is another glyph
+  KDGlyphCache::glyph('a', KDText::FontSize::Small, KDColorBlack, KDColorWhite);
+  KDGlyphCache::glyph('a', KDText::FontSize::Large, KDColorWhite, KDColorBlack);
+  KDGlyphCache::glyph('a', KDText::FontSize::Large, KDColorBlack, KDColorRed);
+  quiz_assert(KDGlyphCache::numberOfHits() == 1);
+  quiz_assert(KDGlyphCache::numberOfMisses() == 4);
+}
+
+QUIZ_CASE(kandinsky_glyph_cache_evicts_least_recently_used) {
+  KDGlyphCache::clear();
+  KDGlyphCache::resetStatistics();
+  for (int i = 0; i < KDGlyphCache::k_numberOfLargeGlyphs; i++) {
+    KDGlyphCache::glyph('A'+i, KDText::FontSize::Large, KDColorBlack, KDColorWhite);
+  }
+  // 'A' was the least recently used glyph, until now
+  KDGlyphCache::glyph('A', KDText::FontSize::Large, KDColorBlack, KDColorWhite);
+  // The large entries are full: 'B' is evicted
+  KDGlyphCache::glyph('0', KDText::FontSize::Large, KDColorBlack, KDColorWhite);
+  quiz_assert(KDGlyphCache::numberOfMisses() == KDGlyphCache::k_numberOfLargeGlyphs + 1);
+  KDGlyphCache::glyph('A', KDText::FontSize::Large, KDColorBlack, KDColorWhite);
+  KDGlyphCache::glyph('C', KDText::FontSize::Large, KDColorBlack, KDColorWhite);
+  quiz_assert(KDGlyphCache::numberOfMisses() == KDGlyphCache::k_numberOfLargeGlyphs + 1);
+  KDGlyphCache::glyph('B', KDText::FontSize::Large, KDColorBlack, KDColorWhite);
+  quiz_assert(KDGlyphCache::numberOfMisses() == KDGlyphCache::k_numberOfLargeGlyphs + 2);
+}
+
+QUIZ_CASE(kandinsky_glyph_cache_font_sizes_have_their_own_entries) {
+  KDGlyphCache::clear();
+  KDGlyphCache::resetStatistics();
+  KDGlyphCache::glyph('A', KDText::FontSize::Small, KDColorBlack, KDColorWhite);
+  // Filling the large entries does not evict small glyphs
+  for (int i = 0; i < KDGlyphCache::k_numberOfLargeGlyphs + 1; i++) {
+    KDGlyphCache::glyph('A'+i, KDText::FontSize::Large, KDColorBlack, KDColorWhite);
+  }
+  KDGlyphCache::glyph('A', KDText::FontSize::Small, KDColorBlack, KDColorWhite);
+  quiz_assert(KDGlyphCache::numberOfHits() == 1);
+}
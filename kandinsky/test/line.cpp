@@ -0,0 +1,89 @@
+#include <quiz.h>
+#include <kandinsky.h>
+#include <assert.h>
+
+constexpr KDCoordinate k_width = 60;
+constexpr KDCoordinate k_height = 40;
+
+/* Bresenham's algorithm, one pixel at a time, as KDContext::drawLine used to
+ * draw lines: the last point is not drawn. */
+static void drawReferenceLine(KDColor * pixels, KDRect clippingRect, KDPoint p1, KDPoint p2, KDColor c) {
+  KDPoint left = p2.x() > p1.x() ? p1 : p2;
+  KDPoint right = p2.x() > p1.x() ? p2 : p1;
+  KDPoint top = p2.y() > p1.y() ? p1 : p2;
+  KDPoint bottom = p2.y() > p1.y() ? p2 : p1;
+  int deltaX = 2*(right.x() - left.x());
+  int deltaY = 2*(bottom.y() - top.y());
+  bool xScan = deltaX >= deltaY;
+  int x = xScan ? left.x() : top.x();
+  int y = xScan ? left.y() : top.y();
+  int scanLength = xScan ? right.x() - left.x() : bottom.y() - top.y();
+  int error = scanLength;
+  int conditionalStep = xScan ? (right.y() >= left.y() ? 1 : -1) : (bottom.x() >= top.x() ? 1 : -1);
+  for (int i = 0; i < scanLength; i++) {
+    if (clippingRect.contains(KDPoint(x, y))) {
+      pixels[x+k_width*y] = c;
+    }
+    if (xScan) {
+      x++;
+    } else {
+      y++;
+    }
+    error -= xScan ? deltaY : deltaX;
+    if (error <= 0) {
+      if (xScan) {
+        y += conditionalStep;
+      } else {
+        x += conditionalStep;
+      }
+      error += xScan ? deltaX : deltaY;
+    }
+  }
+}
+
+static void assert_line_is_drawn_as_reference(KDPoint p1, KDPoint p2, KDRect clippingRect = KDRect(0, 0, k_width, k_height)) {
+  static KDColor pixels[k_width*k_height];
+  static KDColor referencePixels[k_width*k_height];
+  for (int i = 0; i < k_width*k_height; i++) {
+    pixels[i] = KDColorWhite;
+    referencePixels[i] = KDColorWhite;
+  }
+  KDFrameBuffer frameBuffer(pixels, KDSize(k_width, k_height));
+  KDFrameBufferContext context(&frameBuffer);
+  context.setClippingRect(clippingRect);
+  context.drawLine(p1, p2, KDColorRed);
+  drawReferenceLine(referencePixels, clippingRect, p1, p2, KDColorRed);
+  for (int i = 0; i < k_width*k_height; i++) {
+    quiz_assert(pixels[i] == referencePixels[i]);
+  }
+}
+
+QUIZ_CASE(kandinsky_line_draw) {
+  // Horizontal, vertical and diagonal lines, in both directions
+  assert_line_is_drawn_as_reference(KDPoint(2, 3), KDPoint(50, 3));
+  assert_line_is_drawn_as_reference(KDPoint(50, 3), KDPoint(2, 3));
+  assert_line_is_drawn_as_reference(KDPoint(7, 1), KDPoint(7, 35));
+  assert_line_is_drawn_as_reference(KDPoint(7, 35), KDPoint(7, 1));
+  assert_line_is_drawn_as_reference(KDPoint(0, 0), KDPoint(39, 39));
+  assert_line_is_drawn_as_reference(KDPoint(0, 39), KDPoint(39, 0));
+  assert_line_is_drawn_as_reference(KDPoint(5, 5), KDPoint(5, 5));
+  // Every slope from a center point
+  for (int x = 0; x < k_width; x += 3) {
+    assert_line_is_drawn_as_reference(KDPoint(30, 20), KDPoint(x, 0));
+    assert_line_is_drawn_as_reference(KDPoint(30, 20), KDPoint(x, k_height-1));
+  }
+  for (int y = 0; y < k_height; y += 3) {
+    assert_line_is_drawn_as_reference(KDPoint(30, 20), KDPoint(0, y));
+    assert_line_is_drawn_as_reference(KDPoint(30, 20), KDPoint(k_width-1, y));
+  }
+}
+
+QUIZ_CASE(kandinsky_line_draw_clipped) {
+  KDRect clippingRect(10, 8, 30, 20);
+  assert_line_is_drawn_as_reference(KDPoint(0, 0), KDPoint(59, 39), clippingRect);
+  assert_line_is_drawn_as_reference(KDPoint(0, 39), KDPoint(59, 0), clippingRect);
+  assert_line_is_drawn_as_reference(KDPoint(-20, 15), KDPoint(80, 17), clippingRect);
+  assert_line_is_drawn_as_reference(KDPoint(20, -20), KDPoint(25, 60), clippingRect);
+  // Out of the clipping rect
+  assert_line_is_drawn_as_reference(KDPoint(0, 0), KDPoint(59, 5), clippingRect);
+}
@@ -0,0 +1,37 @@
+#include <quiz.h>
+#include <kandinsky.h>
+#include <assert.h>
+
+constexpr KDCoordinate k_width = 20;
+constexpr KDCoordinate k_height = 10;
+
+QUIZ_CASE(kandinsky_get_pixels) {
+  KDColor pixels[k_width*k_height];
+  for (int i = 0; i < k_width*k_height; i++) {
+    pixels[i] = KDColor::RGB16(i);
+  }
+  KDFrameBuffer frameBuffer(pixels, KDSize(k_width, k_height));
+  KDFrameBufferContext context(&frameBuffer);
+  context.setOrigin(KDPoint(2, 1));
+  constexpr KDCoordinate width = 4;
+  constexpr KDCoordinate height = 3;
+  KDColor result[width*height];
+  context.getPixels(KDRect(5, 6, width, height), result);
+  for (int j = 0; j < height; j++) {
+    for (int i = 0; i < width; i++) {
+      quiz_assert(result[i+width*j] == pixels[7+i+k_width*(7+j)]);
+    }
+  }
+  // The pixels outside the clipping rect are left untouched
+  context.setClippingRect(KDRect(8, 8, 10, 2));
+  for (int i = 0; i < width*height; i++) {
+    result[i] = KDColorRed;
+  }
+  context.getPixels(KDRect(5, 6, width, height), result);
+  for (int j = 0; j < height; j++) {
+    for (int i = 0; i < width; i++) {
+      bool isVisible = 7+i >= 8 && 7+j >= 8;
+      quiz_assert(result[i+width*j] == (isVisible ? pixels[7+i+k_width*(7+j)] : KDColorRed));
+    }
+  }
+}
@@ -0,0 +1,82 @@
+#include <quiz.h>
+#include <kandinsky.h>
+#include <assert.h>
+
+constexpr KDCoordinate k_width = 200;
+constexpr KDCoordinate k_height = 50;
+
+/* Draw the glyph of character c at p, as the font bitmap prescribes. When
+ * blending, the background is the previous content of pixels. */
+static void drawReferenceChar(KDColor * pixels, char c, KDPoint p, KDText::FontSize size, KDColor textColor, KDColor backgroundColor, bool blend) {
+  KDSize charSize = KDText::charSize(size);
+  for (int j = 0; j < charSize.height(); j++) {
+    for (int i = 0; i < charSize.width(); i++) {
+      int x = p.x() + i;
+      int y = p.y() + j;
+      if (x < 0 || x >= k_width || y < 0 || y >= k_height) {
+        continue;
+      }
+      uint8_t intensity = size == KDText::FontSize::Large ?
+        bitmapLargeFont[(uint8_t)c-BITMAP_LargeFont_FIRST_CHARACTER][j][i] :
+        bitmapSmallFont[(uint8_t)c-BITMAP_SmallFont_FIRST_CHARACTER][j][i];
+      KDColor backColor = blend ? pixels[x+k_width*y] : backgroundColor;
+      pixels[x+k_width*y] = KDColor::blend(textColor, backColor, intensity);
+    }
+  }
+}
+
+// Draw text as KDContext::drawString does, one character at a time
+static void drawReferenceString(KDColor * pixels, const char * text, KDPoint p, KDText::FontSize size, KDColor textColor, KDColor backgroundColor, bool blend) {
+  KDSize charSize = KDText::charSize(size);
+  KDPoint position = p;
+  while (*text != 0) {
+    if (*text == '\n') {
+      position = KDPoint(0, position.y() + charSize.height());
+    } else if (*text == '\t') {
+      position = position.translatedBy(KDPoint(KDText::k_tabCharacterWidth*charSize.width(), 0));
+    } else {
+      drawReferenceChar(pixels, *text, position, size, textColor, backgroundColor, blend);
+      position = position.translatedBy(KDPoint(charSize.width(), 0));
+    }
+    text++;
+  }
+}
+
+static void assert_string_is_drawn_as_reference(const char * text, KDPoint p, KDText::FontSize size, bool blend) {
+  static KDColor pixels[k_width*k_height];
+  static KDColor referencePixels[k_width*k_height];
+  for (int i = 0; i < k_width*k_height; i++) {
+    pixels[i] = KDColorRed;
+    referencePixels[i] = KDColorRed;
+  }
+  KDFrameBuffer frameBuffer(pixels, KDSize(k_width, k_height));
+  KDFrameBufferContext context(&frameBuffer);
+  if (blend) {
+    context.blendString(text, p, size, KDColorBlue);
+  } else {
+    context.drawString(text, p, size, KDColorBlue, KDColorWhite);
+  }
+  drawReferenceString(referencePixels, text, p, size, KDColorBlue, KDColorWhite, blend);
+  for (int i = 0; i < k_width*k_height; i++) {
+    quiz_assert(pixels[i] == referencePixels[i]);
+  }
+}
+
+QUIZ_CASE(kandinsky_text_draw_string) {
+  assert_string_is_drawn_as_reference("Hello, World!", KDPoint(3, 2), KDText::FontSize::Large, false);
+  assert_string_is_drawn_as_reference("Hello, World!", KDPoint(3, 2), KDText::FontSize::Small, false);
+  assert_string_is_drawn_as_reference("1+2\t=3\nabc", KDPoint(5, 0), KDText::FontSize::Large, false);
+  // Longer than a glyph run
+  assert_string_is_drawn_as_reference("0123456789abcdefghijklmnopqrstuvwxyz", KDPoint(0, 20), KDText::FontSize::Small, false);
+  assert_string_is_drawn_as_reference("Hello, World!", KDPoint(3, 2), KDText::FontSize::Large, true);
+}
+
+QUIZ_CASE(kandinsky_text_draw_clipped_string) {
+  // Clipped on the left and on the top, in the middle of a glyph
+  assert_string_is_drawn_as_reference("Hello, World!", KDPoint(-13, -5), KDText::FontSize::Large, false);
+  // Clipped on the right and on the bottom
+  assert_string_is_drawn_as_reference("0123456789abcdefghijklmnopqrstuvwxyz", KDPoint(-4, 40), KDText::FontSize::Large, false);
+  assert_string_is_drawn_as_reference("0123456789abcdefghijklmnopqrstuvwxyz", KDPoint(-4, 40), KDText::FontSize::Small, true);
+  // Out of the frame buffer
+  assert_string_is_drawn_as_reference("Hello", KDPoint(-60, 0), KDText::FontSize::Large, false);
+}
@@ -34,6 +34,7 @@
 #include <poincare/arc_sine.h>
 #include <poincare/arc_tangent.h>
 #include <poincare/binomial_coefficient.h>
+#include <poincare/compiled_expression.h>
 #include <poincare/complex_argument.h>
 #include <poincare/confidence_interval.h>
 #include <poincare/conjugate.h>
@@ -98,6 +99,7 @@
 #include <poincare/sum.h>
 #include <poincare/symbol.h>
 #include <poincare/tangent.h>
+#include <poincare/thread_context.h>
 #include <poincare/undefined.h>
 #include <poincare/variable_context.h>
 
@@ -13,19 +13,12 @@ public:
    * i could not be factorized.
    * Before calling PrimeFactorization, we initiate two tables of Integers
    * (outputFactors & outputCoefficients) of length k_maxNumberOfPrimeFactors = 32.
-   * As explained in 'integer.h', we guarantee the existence of only 16 Integers
-   * simultaneously. However, primeFactors are capped by
-   * k_biggestPrimeFactor*k_biggestPrimeFactor and they thus benefit from the
-   * small integer optimization. Thereby, the tables will not allocate any
-   * Integer on the static Integer table that limit the number of Integer
-   * simultaneously alive. */
+   * The small prime factors are found by trial division over primeFactors,
+   * the larger ones by Pollard's rho algorithm, whose number of steps is
+   * bounded: PrimeFactorization returns -2 when it runs out of steps. */
   static int PrimeFactorization(const Integer & i, Integer outputFactors[], Integer outputCoefficients[], int outputLength);
   constexpr static int k_numberOfPrimeFactors = 1000;
   constexpr static int k_maxNumberOfPrimeFactors = 32;
-private:
-  /* When decomposing an integer into primes factors, we look for its prime
-   * factors among integer from 2 to 10000. */
-  constexpr static int k_biggestPrimeFactor = 10000;
 };
 
 }
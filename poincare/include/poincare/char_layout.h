@@ -17,6 +17,7 @@ public:
 
   // CharLayout
   virtual void setChar(char c) { m_char = c; }
+  char character() const { return m_char; }
   KDText::FontSize fontSize() const { return m_fontSize; }
   void setFontSize(KDText::FontSize fontSize) { m_fontSize = fontSize; }
 
@@ -25,6 +26,7 @@ public:
   void moveCursorRight(LayoutCursor * cursor, bool * shouldRecomputeLayout) override;
   int serialize(char * buffer, int bufferSize, Preferences::PrintFloatMode floatDisplayMode, int numberOfSignificantDigits) const override;
   bool isCollapsable(int * numberOfOpenParenthesis, bool goingLeft) const override;
+  bool isChar() const override { return true; }
 
   // TreeNode
   size_t size() const override { return sizeof(CharLayoutNode); }
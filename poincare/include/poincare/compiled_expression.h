@@ -0,0 +1,114 @@
+#ifndef POINCARE_COMPILED_EXPRESSION_H
+#define POINCARE_COMPILED_EXPRESSION_H
+
+#include <poincare/expression.h>
+#include <poincare/context.h>
+#include <stdint.h>
+
+namespace Poincare {
+
+class SymbolNode;
+
+/* A CompiledExpression is a reduced expression lowered into a flat program
+ * for a small stack machine, so that it can be approximated many times for
+ * different values of one symbol (a curve, a values table, a root finder...)
+ * without walking the TreePool tree nor allocating Evaluation nodes.
+ *
+ * The program only handles real numbers. Every sub-expression which does not
+ * depend on the symbol nor on the context (like "2", "π/3" or "binomial(5,2)")
+ * is approximated once at compilation. The other symbols are looked up in the
+ * context at each approximation, as for the tree evaluation.
+ * Whenever the compilation fails (a matrix, a complex constant, an unhandled
+ * function of the symbol...) or the approximation steps outside the real
+ * domain (a square root of a negative number, an infinite intermediate
+ * result...), we fall back on Expression::approximateWithValueForSymbol, so
+ * that both approximations agree on the domain and on undefined values. They
+ * do not agree bit for bit: the program computes powers and roots with the
+ * real std::pow where the tree uses the complex one, and the results might
+ * differ in the last digits.
+ *
+ * approximateWithValuesForSymbol runs the program on a whole array of values
+ * at once: each instruction is dispatched once per batch of k_batchSize values
+ * and applied to contiguous spans, which the compiler can vectorize for the
+ * arithmetic operations. */
+
+template<typename T>
+class CompiledExpression {
+public:
+  CompiledExpression();
+  CompiledExpression(const Expression e, char symbol, Context & context, Preferences::AngleUnit angleUnit);
+  bool isUninitialized() const { return m_expression.isUninitialized(); }
+  bool isCompiled() const { return m_numberOfInstructions > 0; }
+  Preferences::AngleUnit angleUnit() const { return m_angleUnit; }
+  T approximateWithValueForSymbol(T x, Context & context) const;
+  void approximateWithValuesForSymbol(const T * x, T * results, int numberOfValues, Context & context) const;
+private:
+  enum class OperationCode : uint8_t {
+    PushConstant,
+    PushSymbol,
+    PushVariable,
+    Addition,
+    Subtraction,
+    Multiplication,
+    Division,
+    Power,
+    NthRoot,
+    LogarithmWithBase,
+    Opposite,
+    AbsoluteValue,
+    SquareRoot,
+    NaperianLogarithm,
+    Logarithm,
+    Sine,
+    Cosine,
+    Tangent,
+    ArcSine,
+    ArcCosine,
+    ArcTangent,
+    HyperbolicSine,
+    HyperbolicCosine,
+    HyperbolicTangent,
+    Floor,
+    Ceiling,
+    FracPart
+  };
+  struct Instruction {
+    OperationCode code;
+    /* Index of the constant for PushConstant, of the symbol for PushSymbol,
+     * unused otherwise */
+    uint8_t operand;
+  };
+  constexpr static int k_maxNumberOfInstructions = 40;
+  constexpr static int k_maxNumberOfConstants = 12;
+  constexpr static int k_maxNumberOfSymbols = 4;
+  constexpr static int k_maxStackDepth = 12;
+  constexpr static int k_batchSize = 16;
+
+  // Compilation
+  bool compile(const ExpressionNode * e, int * depth, Context & context);
+  bool isConstant(const ExpressionNode * e) const;
+  bool pushConstant(T value, int * depth);
+  bool pushSymbol(const SymbolNode * symbol, int * depth);
+  bool pushInstruction(OperationCode code, uint8_t operand, int stackDelta, int * depth);
+  // Approximation
+  bool run(T x, Context & context, T * result) const;
+  void runBatch(const T * x, int numberOfValues, Context & context, T * results, bool * failed) const;
+  static bool computeUnary(OperationCode code, T a, Preferences::AngleUnit angleUnit, T * result);
+  static bool computeBinary(OperationCode code, T a, T b, T * result);
+
+  Expression m_expression;
+  char m_symbol;
+  Preferences::AngleUnit m_angleUnit;
+  uint8_t m_numberOfInstructions;
+  uint8_t m_numberOfConstants;
+  uint8_t m_numberOfSymbols;
+  Instruction m_instructions[k_maxNumberOfInstructions];
+  T m_constants[k_maxNumberOfConstants];
+  /* Handles on the symbol nodes of m_expression, so that approximating them
+   * does not create a Symbol in the pool */
+  Expression m_symbols[k_maxNumberOfSymbols];
+};
+
+}
+
+#endif
@@ -33,6 +33,7 @@ public:
   }
   T toScalar() const override;
   Expression complexToExpression(Preferences::Preferences::ComplexFormat complexFormat) const override;
+  static Expression ComplexToExpression(std::complex<T> c, Preferences::ComplexFormat complexFormat);
   std::complex<T> trace() const override { return *this; }
   std::complex<T> determinant() const override { return *this; }
 };
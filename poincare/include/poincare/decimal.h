@@ -59,6 +59,7 @@ public:
 
   // Comparison
   int simplificationOrderSameType(const ExpressionNode * e, bool canBeInterrupted) const override;
+  uint8_t computeStructuralHash() const override;
 
   // Simplification
   Expression shallowReduce(Context & context, Preferences::AngleUnit angleUnit) override;
@@ -74,7 +75,10 @@ private:
   constexpr static int k_maxBufferSize = PrintFloat::k_numberOfStoredSignificantDigits+1+1+1+1+4+1;
   int convertToText(char * buffer, int bufferSize, Preferences::PrintFloatMode mode, int numberOfSignificantDigits) const;
   template<typename T> Evaluation<T> templatedApproximate() const;
-  void setNegative(bool negative) { m_negative = negative; }
+  void setNegative(bool negative) {
+    m_negative = negative;
+    invalidateCachedHash();
+  }
   bool m_negative;
   int m_exponent;
   uint8_t m_numberOfDigitsInMantissa;
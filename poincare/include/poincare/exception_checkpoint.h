@@ -3,6 +3,8 @@
 
 #include "tree_pool.h"
 #include "tree_node.h"
+#include "integer_digit_arena.h"
+#include "thread_local.h"
 #include <setjmp.h>
 
 
@@ -47,10 +49,11 @@ public:
 private:
   void rollback();
 
-  static ExceptionCheckpoint * s_topmostExceptionCheckpoint;
+  static POINCARE_THREAD_LOCAL ExceptionCheckpoint * s_topmostExceptionCheckpoint;
 
   jmp_buf m_jumpBuffer;
   TreeNode * m_endOfPoolBeforeCheckpoint;
+  IntegerDigitArena::Snapshot m_integerDigitsBeforeCheckpoint;
   ExceptionCheckpoint * m_parent;
 };
 
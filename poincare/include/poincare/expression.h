@@ -12,6 +12,7 @@
 namespace Poincare {
 
 class Context;
+template<typename T> class CompiledExpression;
 
 class Expression : public TreeHandle {
   friend class AbsoluteValue;
@@ -69,6 +70,8 @@ class Expression : public TreeHandle {
   friend class Trigonometry;
 
   friend class AdditionNode;
+  template<typename T>
+  friend class CompiledExpression;
   friend class DerivativeNode;
   friend class EqualNode;
   template<typename T>
@@ -149,6 +152,13 @@ public:
    * same structures and all their nodes have same types and values (ie,
    * sqrt(pi^2) is NOT identical to pi). */
   bool isIdenticalTo(const Expression e) const;
+#if DEBUG
+  /* Statistics on isIdenticalTo: the structural hashes of the expressions
+   * spare most of the comparisons of different expressions. */
+  static int NumberOfIdentityTests();
+  static int NumberOfAvoidedComparisons();
+  static void ResetIdentityTestsStatistics();
+#endif
   bool isEqualToItsApproximationLayout(Expression approximation, char * buffer, int bufferSize, Preferences::AngleUnit angleUnit, Preferences::PrintFloatMode floatDisplayMode, int numberOfSignificantDigits, Context & context);
 
   /* Layout Helper */
@@ -166,6 +176,7 @@ public:
   template<typename U> U approximateToScalar(Context& context, Preferences::AngleUnit angleUnit) const;
   template<typename U> static U approximateToScalar(const char * text, Context& context, Preferences::AngleUnit angleUnit);
   template<typename U> U approximateWithValueForSymbol(char symbol, U x, Context & context, Preferences::AngleUnit angleUnit) const;
+  template<typename U> void approximateWithValuesForSymbol(char symbol, const U * x, U * results, int numberOfValues, Context & context, Preferences::AngleUnit angleUnit) const;
   /* Expression roots/extrema solver */
   struct Coordinate2D {
     double abscissa;
@@ -174,6 +185,10 @@ public:
   Coordinate2D nextMinimum(char symbol, double start, double step, double max, Context & context, Preferences::AngleUnit angleUnit) const;
   Coordinate2D nextMaximum(char symbol, double start, double step, double max, Context & context, Preferences::AngleUnit angleUnit) const;
   double nextRoot(char symbol, double start, double step, double max, Context & context, Preferences::AngleUnit angleUnit) const;
+  /* nextRoots finds the first roots after start in a single sweep of the
+   * interval. It fills roots with at most maxNumberOfRoots of them, in the
+   * order they are met, and returns their number. */
+  int nextRoots(char symbol, double start, double step, double max, double * roots, int maxNumberOfRoots, Context & context, Preferences::AngleUnit angleUnit) const;
   Coordinate2D nextIntersection(char symbol, double start, double step, double max, Context & context, Preferences::AngleUnit angleUnit, const Expression expression) const;
 
 protected:
@@ -237,13 +252,24 @@ private:
   constexpr static double k_sqrtEps = 1.4901161193847656E-8; // sqrt(DBL_EPSILON)
   constexpr static double k_goldenRatio = 0.381966011250105151795413165634361882279690820194237137864; // (3-sqrt(5))/2
   constexpr static double k_maxFloat = 1e100;
-  typedef double (*EvaluationAtAbscissa)(char symbol, double abscissa, Context & context, Preferences::AngleUnit angleUnit, const Expression expression0, const Expression expression1);
-  Coordinate2D nextMinimumOfExpression(char symbol, double start, double step, double max, EvaluationAtAbscissa evaluation, Context & context, Preferences::AngleUnit angleUnit, const Expression expression = Expression(), bool lookForRootMinimum = false) const;
-  void bracketMinimum(char symbol, double start, double step, double max, double result[3], EvaluationAtAbscissa evaluation, Context & context, Preferences::AngleUnit angleUnit, const Expression expression = Expression()) const;
-  Coordinate2D brentMinimum(char symbol, double ax, double bx, EvaluationAtAbscissa evaluation, Context & context, Preferences::AngleUnit angleUnit, const Expression expression = Expression()) const;
-  double nextIntersectionWithExpression(char symbol, double start, double step, double max, EvaluationAtAbscissa evaluation, Context & context, Preferences::AngleUnit angleUnit, const Expression expression) const;
-  void bracketRoot(char symbol, double start, double step, double max, double result[2], EvaluationAtAbscissa evaluation, Context & context, Preferences::AngleUnit angleUnit, const Expression expression) const;
-  double brentRoot(char symbol, double ax, double bx, double precision, EvaluationAtAbscissa evaluation, Context & context, Preferences::AngleUnit angleUnit, const Expression expression) const;
+  typedef double (*EvaluationAtAbscissa)(double abscissa, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1);
+  // expression0-expression1, or expression0 if expression1 is uninitialized
+  static double evaluateDifference(double x, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1);
+  static double evaluateOppositeOfDifference(double x, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1);
+  static Coordinate2D nextMinimumOfExpression(double start, double step, double max, EvaluationAtAbscissa evaluation, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1, bool lookForRootMinimum = false);
+  static void bracketMinimum(double start, double step, double max, double result[3], EvaluationAtAbscissa evaluation, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1);
+  static Coordinate2D brentMinimum(double ax, double bx, EvaluationAtAbscissa evaluation, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1);
+  static double nextIntersectionWithExpression(double start, double step, double max, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1);
+  static int nextIntersectionsWithExpression(double start, double step, double max, double * results, int maxNumberOfResults, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1);
+  static void addIntersection(double x, double start, double step, double * results, int * numberOfResults, int maxNumberOfResults);
+  /* bracketRoot and nextIntersectionsWithExpression sample
+   * expression0-expression1 (or expression0 if expression1 is uninitialized)
+   * by batches of abscissae. */
+  constexpr static int k_bracketRootBatchSize = 16;
+  static void approximateDifferenceWithValues(const double * abscissae, double * values, int numberOfAbscissae, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1);
+  // bracketRoot and brentRoot look for a root of evaluateDifference
+  static void bracketRoot(double start, double step, double max, double result[2], Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1);
+  static double brentRoot(double ax, double bx, double precision, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1);
 };
 
 }
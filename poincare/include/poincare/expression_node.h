@@ -134,6 +134,10 @@ public:
    * reimplement simplificationOrderGreaterType. */
   virtual int simplificationOrderGreaterType(const ExpressionNode * e, bool canBeInterrupted) const { return -1; }
   virtual int simplificationOrderSameType(const ExpressionNode * e, bool canBeInterrupted) const;
+  /* Expressions with a null SimplificationOrder have the same structural hash,
+   * so that different hashes spare comparing the expressions. The hash is
+   * cached in the node until the node or one of its descendants changes. */
+  uint8_t structuralHash() const;
 
   /* Layout Helper */
   virtual Layout createLayout(Preferences::PrintFloatMode floatDisplayMode, int numberOfSignificantDigits) const = 0;
@@ -156,6 +160,21 @@ public:
   virtual void setChildrenInPlace(Expression other);
 
 protected:
+  /* Structural hash
+   * The hash has to be consistent with simplificationOrderSameType and
+   * simplificationOrderGreaterType: it can only include what they compare. By
+   * default, it depends on the type and the children. */
+  virtual uint8_t computeStructuralHash() const;
+  static uint32_t CombineHash(uint32_t hash, uint32_t value) {
+    return (hash ^ value) * 16777619;
+  }
+  // Fold the hash to a byte, avoiding 0 which means no cached hash
+  static uint8_t FoldHash(uint32_t hash) {
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return (hash & 0xFF) == 0 ? 1 : hash;
+  }
+
   /* Hierarchy */
   ExpressionNode * parent() const override { return static_cast<ExpressionNode *>(TreeNode::parent()); }
   Direct<ExpressionNode> children() const { return Direct<ExpressionNode>(this); }
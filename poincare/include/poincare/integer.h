@@ -13,7 +13,6 @@ class LayoutNode;
 class Integer;
 struct IntegerDivision;
 
-typedef uint16_t half_native_uint_t;
 typedef int32_t native_int_t;
 typedef int64_t double_native_int_t;
 typedef uint32_t native_uint_t;
@@ -106,11 +105,10 @@ private:
   Integer(native_uint_t * digits, uint16_t numberOfDigits, bool negative, bool enableOverflow = false);
 
   // Dynamic allocation
-  /* In order to guarantee the potential existence of 16 Integers simutaneously,
-   * we keep a table uint32_t that can contain up to 16 Integers with the
-   * maximal numbers of digits. We also give them one extra digit to be able to
-   * perform complex operations (like division) which involve Integers with one
-   *  additional digit. */
+  /* The digits are allocated in the IntegerDigitArena, which can contain at
+   * least 16 Integers with the maximal numbers of digits simutaneously. We also
+   * give them one extra digit to be able to perform complex operations (like
+   * division) which involve Integers with one additional digit. */
   static native_uint_t * allocDigits(int numberOfDigits);
   static void freeDigits(native_uint_t * digits);
 
@@ -126,24 +124,6 @@ private:
   static int8_t ucmp(const Integer & a, const Integer & b); // -1, 0, or 1
   static Integer usum(const Integer & a, const Integer & b, bool subtract, bool oneDigitOverflow = false);
   static IntegerDivision udiv(const Integer & a, const Integer & b);
-  Integer multiplyByPowerOf2(uint8_t pow) const;
-  Integer divideByPowerOf2(uint8_t pow) const;
-  Integer multiplyByPowerOfBase(uint8_t pow) const;
-
-  // HalfDigits
-  uint16_t numberOfHalfDigits() const {
-    if (m_numberOfDigits == 0) { return 0; }
-    native_uint_t d = digit(m_numberOfDigits-1);
-    native_uint_t halfBase = 1 << (8*sizeof(half_native_uint_t));
-    return (d >= halfBase ? 2*m_numberOfDigits : 2*m_numberOfDigits-1);
-  }
-  half_native_uint_t halfDigit(int i) const {
-    assert(i >= 0);
-    if (i >= numberOfHalfDigits()) {
-      return 0;
-    }
-    return (usesImmediateDigit() ? ((half_native_uint_t *)&m_digit)[i] : ((half_native_uint_t *)m_digits)[i]);
-  }
 
   bool usesImmediateDigit() const { return m_numberOfDigits == 1; }
   native_uint_t digit(uint8_t i) const {
@@ -102,6 +102,7 @@ public:
   /* For now, mustHaveLeftSibling and isVerticalOffset behave the same, but code
    * is clearer with different names. */
   virtual bool isHorizontal() const { return false; }
+  virtual bool isChar() const { return false; }
   virtual bool isLeftParenthesis() const { return false; }
   virtual bool isRightParenthesis() const { return false; }
   virtual bool isLeftBracket() const { return false; }
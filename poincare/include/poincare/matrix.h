@@ -82,6 +82,9 @@ public:
   int rank(Context & context, Preferences::AngleUnit angleUnit, bool inPlace = false);
   // Inverse the array in-place. Array has to be given in the form array[row_index][column_index]
   template<typename T> static int ArrayInverse(T * array, int numberOfRows, int numberOfColumns);
+  /* Multiply the arrays a (m x n) and b (n x p) into result, which must not
+   * overlap a nor b. Arrays are given in the form array[row_index][column_index] */
+  template<typename T> static void ArrayMultiply(const T * a, const T * b, T * result, int m, int n, int p);
 #if MATRIX_EXACT_REDUCING
   Expression trace() const;
   Expression determinant() const;
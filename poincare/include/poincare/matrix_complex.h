@@ -9,6 +9,12 @@ namespace Poincare {
 template<typename T>
 class MatrixComplex;
 
+/* The coefficients of a MatrixComplexNode are stored inline, right after the
+ * node in the pool, instead of as children ComplexNodes: accessing one of them
+ * is not a walk through its siblings and the kernels of Matrix work on them
+ * directly. The size of the node is thus fixed by its dimensions when it is
+ * created. */
+
 template<typename T>
 class MatrixComplexNode : public EvaluationNode<T> {
 public:
@@ -18,12 +24,16 @@ public:
     m_numberOfColumns(0)
   {}
 
-  std::complex<T> complexAtIndex(int index) const;
+  std::complex<T> complexAtIndex(int index) const {
+    assert(index >= 0 && index < numberOfCoefficients());
+    return m_coefficients[index];
+  }
+  void setComplexAtIndex(int index, std::complex<T> c);
+  int numberOfCoefficients() const { return m_numberOfRows*m_numberOfColumns; }
 
   // TreeNode
-  size_t size() const override { return sizeof(MatrixComplexNode<T>); }
-  int numberOfChildren() const override { return m_numberOfRows*m_numberOfColumns; }
-  void didAddChildAtIndex(int newNumberOfChildren) override;
+  size_t size() const override;
+  int numberOfChildren() const override { return 0; }
 #if POINCARE_TREE_LOG
   virtual void logNodeName(std::ostream & stream) const override {
     stream << "MatrixComplex";
@@ -38,18 +48,27 @@ public:
   typename EvaluationNode<T>::Type type() const override { return EvaluationNode<T>::Type::MatrixComplex; }
   int numberOfRows() const { return m_numberOfRows; }
   int numberOfColumns() const { return m_numberOfColumns; }
-  virtual void setNumberOfRows(int rows) { assert(rows >= 0); m_numberOfRows = rows; }
-  virtual void setNumberOfColumns(int columns) { assert(columns >= 0); m_numberOfColumns = columns; }
   bool isUndefined() const override;
   Expression complexToExpression(Preferences::Preferences::ComplexFormat complexFormat) const override;
   std::complex<T> trace() const override;
   std::complex<T> determinant() const override;
   MatrixComplex<T> inverse() const;
   MatrixComplex<T> transpose() const;
+  MatrixComplex<T> multiply(const MatrixComplexNode<T> * n) const;
+  MatrixComplex<T> power(int exponent) const;
 private:
+  friend class MatrixComplex<T>;
+  void setDimensions(int rows, int columns) {
+    assert(rows >= 0 && columns >= 0);
+    m_numberOfRows = rows;
+    m_numberOfColumns = columns;
+  }
+
   // See comment on Matrix
   uint16_t m_numberOfRows;
   uint16_t m_numberOfColumns;
+  // Coefficients, in the form m_coefficients[row_index*m_numberOfColumns+column_index]
+  std::complex<T> m_coefficients[0];
 };
 
 template<typename T>
@@ -57,29 +76,25 @@ class MatrixComplex : public Evaluation<T> {
   friend class MatrixComplexNode<T>;
 public:
   MatrixComplex(MatrixComplexNode<T> * node) : Evaluation<T>(node) {}
-  MatrixComplex();
-  MatrixComplex(std::complex<T> * operands, int numberOfRows, int numberOfColumns);
+  // The coefficients of the matrix are undefined until they are set
+  MatrixComplex(int numberOfRows, int numberOfColumns);
+  MatrixComplex(const std::complex<T> * operands, int numberOfRows, int numberOfColumns);
   static MatrixComplex<T> Undefined();
   static MatrixComplex<T> createIdentity(int dim);
   MatrixComplex<T> inverse() const { return node()->inverse(); }
   MatrixComplex<T> transpose() const { return node()->transpose(); }
+  MatrixComplex<T> multiply(const MatrixComplex<T> n) const { return node()->multiply(n.node()); }
+  MatrixComplex<T> power(int exponent) const { return node()->power(exponent); }
   std::complex<T> complexAtIndex(int index) const {
     return node()->complexAtIndex(index);
   }
+  void setComplexAtIndex(int index, std::complex<T> c) {
+    node()->setComplexAtIndex(index, c);
+  }
   int numberOfRows() const { return node()->numberOfRows(); }
   int numberOfColumns() const { return node()->numberOfColumns(); }
-  void setDimensions(int rows, int columns);
-  void addChildAtIndexInPlace(Evaluation<T> t, int index, int currentNumberOfChildren);
+  int numberOfCoefficients() const { return node()->numberOfCoefficients(); }
 private:
-  MatrixComplexNode<T> * node() { return static_cast<MatrixComplexNode<T> *>(Evaluation<T>::node()); }
-  void setNumberOfRows(int rows) {
-    assert(rows >= 0);
-    node()->setNumberOfRows(rows);
-  }
-  void setNumberOfColumns(int columns) {
-    assert(columns >= 0);
-    node()->setNumberOfColumns(columns);
-  }
   MatrixComplexNode<T> * node() const { return static_cast<MatrixComplexNode<T> *>(Evaluation<T>::node()); }
 };
 
@@ -30,8 +30,13 @@ protected:
    * than 6144 children which fit in uint16_t. */
   uint16_t m_numberOfChildren;
 private:
+  /* Above this number of children, the arrays of children needed by the
+   * merge sort would take too much of the stack. */
+  constexpr static int k_maxNumberOfChildrenToMergeSort = 256;
+  void sortChildrenInPlaceBySwaps(ExpressionOrder order, bool canBeInterrupted);
   int simplificationOrderSameType(const ExpressionNode * e, bool canBeInterrupted) const override;
   int simplificationOrderGreaterType(const ExpressionNode * e, bool canBeInterrupted) const override;
+  uint8_t computeStructuralHash() const override;
 };
 
 class NAryExpression : public Expression {
@@ -19,7 +19,10 @@ public:
   Integer unsignedNumerator() const;
   Integer denominator() const;
   bool isNegative() const { return m_negative; }
-  void setNegative(bool negative) { m_negative = negative; }
+  void setNegative(bool negative) {
+    m_negative = negative;
+    invalidateCachedHash();
+  }
 
   // TreeNode
   size_t size() const override;
@@ -54,8 +57,11 @@ public:
   bool isTen() const { return signedNumerator().isTen() && denominator().isOne(); }
 
   static int NaturalOrder(const RationalNode * i, const RationalNode * j);
+  static uint8_t OneStructuralHash();
 private:
   int simplificationOrderSameType(const ExpressionNode * e, bool canBeInterrupted) const override;
+  uint8_t computeStructuralHash() const override;
+  static uint8_t StructuralHash(bool negative, const native_uint_t * numeratorDigits, uint8_t numeratorSize, const native_uint_t * denominatorDigits, uint8_t denominatorSize);
   Expression shallowReduce(Context & context, Preferences::AngleUnit angleUnit) override;
   Expression shallowBeautify(Context & context, Preferences::AngleUnit angleUnit) override;
   Expression setSign(Sign s, Context & context, Preferences::AngleUnit angleUnit) override;
@@ -11,7 +11,10 @@ public:
   SymbolNode() : m_name(0) {}
 
 
-  void setName(const char name) { m_name = name; }
+  void setName(const char name) {
+    m_name = name;
+    invalidateCachedHash();
+  }
   char name() const { return m_name; }
 
   // TreeNode
@@ -37,6 +40,7 @@ public:
 
   /* Comparison */
   int simplificationOrderSameType(const ExpressionNode * e, bool canBeInterrupted) const override;
+  uint8_t computeStructuralHash() const override;
 
 /* Layout */
   Layout createLayout(Preferences::PrintFloatMode floatDisplayMode, int numberOfSignificantDigits) const override;
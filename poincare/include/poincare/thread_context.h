@@ -0,0 +1,36 @@
+#ifndef POINCARE_THREAD_CONTEXT_H
+#define POINCARE_THREAD_CONTEXT_H
+
+#include <poincare/tree_pool.h>
+#include <poincare/thread_local.h>
+
+namespace Poincare {
+
+/* A ThreadContext owns the TreePool of the thread which creates it, and
+ * registers it as the shared pool of that thread for its whole lifetime.
+ * Poincare::init() provides the pool of the main thread: any other thread
+ * using Poincare must hold a ThreadContext, and destroy every expression and
+ * layout it created before the context goes away. Trees live in the pool of
+ * the thread which built them, so they cannot be handed to another thread.
+ *
+ * Without POINCARE_MULTITHREAD, there is a single pool for the whole process,
+ * and a ThreadContext must not be created.
+ *
+ * The exception checkpoints, the integer buffer, the circuit breaker and the
+ * scanner of the parser are thread-local as well. The Preferences and the
+ * Ion::Storage read by the GlobalContext are shared: they must not be modified
+ * while other threads run. */
+
+class ThreadContext {
+public:
+  ThreadContext() { TreePool::RegisterPool(&m_pool); }
+  ~ThreadContext() { TreePool::UnregisterPool(&m_pool); }
+  ThreadContext(const ThreadContext & other) = delete;
+  ThreadContext & operator=(const ThreadContext & other) = delete;
+private:
+  TreePool m_pool;
+};
+
+}
+
+#endif
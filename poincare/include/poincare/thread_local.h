@@ -0,0 +1,17 @@
+#ifndef POINCARE_THREAD_LOCAL_H
+#define POINCARE_THREAD_LOCAL_H
+
+/* The device runs Poincare on a single thread. Host builds defining
+ * POINCARE_MULTITHREAD may run Poincare on several threads at once: the
+ * mutable state of Poincare (the pool, the exception checkpoints, the integer
+ * buffer, the circuit breaker, the scanner of the parser...) is then qualified
+ * with POINCARE_THREAD_LOCAL so that each thread has its own (see
+ * ThreadContext). */
+
+#if POINCARE_MULTITHREAD
+#define POINCARE_THREAD_LOCAL thread_local
+#else
+#define POINCARE_THREAD_LOCAL
+#endif
+
+#endif
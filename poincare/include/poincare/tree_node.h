@@ -14,7 +14,9 @@
  *  - an identifier
  *  - a parent identifier
  *  - a reference counter
- */
+ *  - a cached hash
+ * The cached hash is a single byte, so that it fits in the padding that
+ * follows the reference counter and no node of the pool grows. */
 
 namespace Poincare {
 
@@ -42,6 +44,18 @@ public:
   void release(int currentNumberOfChildren);
   void rename(int identifier, bool unregisterPreviousIdentifier);
 
+  /* Cached hash, computed by subclasses from the node and its descendants
+   * (see ExpressionNode::structuralHash). A node can only have a cached hash
+   * if all its descendants have one. */
+  bool hasCachedHash() const { return m_cachedHash != k_noCachedHash; }
+  uint8_t cachedHash() const { assert(hasCachedHash()); return m_cachedHash; }
+  void setCachedHash(uint8_t hash) const {
+    assert(hash != k_noCachedHash);
+    m_cachedHash = hash;
+  }
+  // Must be called whenever the node or its children change
+  void invalidateCachedHash();
+
   // Hierarchy
   virtual TreeNode * parent() const;
   virtual TreeNode * root();
@@ -130,7 +144,8 @@ protected:
   TreeNode() :
     m_identifier(NoNodeIdentifier),
     m_parentIdentifier(NoNodeIdentifier),
-    m_referenceCounter(0)
+    m_referenceCounter(0),
+    m_cachedHash(k_noCachedHash)
   {}
 private:
   void updateParentIdentifierInChildren() const {
@@ -139,7 +154,9 @@ private:
   void changeParentIdentifierInChildren(int id) const;
   int16_t m_identifier;
   int16_t m_parentIdentifier;
+  constexpr static uint8_t k_noCachedHash = 0;
   int8_t m_referenceCounter;
+  mutable uint8_t m_cachedHash;
 };
 
 }
@@ -3,6 +3,7 @@
 
 #include "tree_node.h"
 #include <poincare/ghost_node.h>
+#include <poincare/thread_local.h>
 #include <stddef.h>
 #include <string.h>
 #include <new>
@@ -22,6 +23,7 @@ class TreePool {
 public:
   static TreePool * sharedPool() { assert(SharedStaticPool != nullptr); return SharedStaticPool; }
   static void RegisterPool(TreePool * pool) {  assert(SharedStaticPool == nullptr); SharedStaticPool = pool; }
+  static void UnregisterPool(TreePool * pool) { assert(SharedStaticPool == pool); SharedStaticPool = nullptr; }
 
   TreePool() : m_cursor(m_buffer) {}
 
@@ -37,6 +39,9 @@ public:
   void moveChildren(TreeNode * destination, TreeNode * sourceParent);
   void removeChildren(TreeNode * node, int nodeNumberOfChildren);
   void removeChildrenAndDestroy(TreeNode * nodeToDestroy, int nodeNumberOfChildren);
+  /* Reorder the children of node as listed in orderedChildren, which is used
+   * as a scratch buffer. */
+  void reorderChildren(TreeNode * node, TreeNode ** orderedChildren, int numberOfChildren);
 
   TreeNode * deepCopy(TreeNode * node);
   TreeNode * copyTreeFromAddress(const void * address, size_t size);
@@ -51,7 +56,7 @@ public:
 private:
   constexpr static int BufferSize = 32768;
   constexpr static int MaxNumberOfNodes = BufferSize/sizeof(TreeNode);
-  static TreePool * SharedStaticPool;
+  static POINCARE_THREAD_LOCAL TreePool * SharedStaticPool;
 
   // TreeNode
   void addGhostChildrenAndRename(TreeNode * node);
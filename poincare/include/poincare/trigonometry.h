@@ -17,12 +17,15 @@ public:
   static Expression shallowReduceInverseFunction(Expression & e, Context& context, Preferences::AngleUnit angleUnit);
   static bool ExpressionIsEquivalentToTangent(const Expression & e);
   constexpr static int k_numberOfEntries = 37;
+  constexpr static int k_numberOfColumns = 5;
   static Expression table(const Expression e, ExpressionNode::Type type, Context & context, Preferences::AngleUnit angleUnit); // , Function f, bool inverse
   template <typename T> static std::complex<T> ConvertToRadian(const std::complex<T> c, Preferences::AngleUnit angleUnit);
   template <typename T> static std::complex<T> ConvertRadianToAngleUnit(const std::complex<T> c, Preferences::AngleUnit angleUnit);
   template <typename T> static std::complex<T> RoundToMeaningfulDigits(const std::complex<T> c);
-private:
   template <typename T> static T RoundToMeaningfulDigits(T f);
+private:
+  constexpr static double k_cheatTableValuePrecision = 1E-5;
+  static const float * cheatTableValues(Context & context, Preferences::AngleUnit angleUnit);
 };
 
 }
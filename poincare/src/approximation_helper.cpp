@@ -34,11 +34,10 @@ template<typename T> Evaluation<T> ApproximationHelper::Map(const ExpressionNode
   } else {
     assert(input.type() == EvaluationNode<T>::Type::MatrixComplex);
     MatrixComplex<T> m = static_cast<MatrixComplex<T> &>(input);
-    MatrixComplex<T> result;
-    for (int i = 0; i < m.numberOfChildren(); i++) {
-      result.addChildAtIndexInPlace(compute(m.complexAtIndex(i), angleUnit), i, i);
+    MatrixComplex<T> result(m.numberOfRows(), m.numberOfColumns());
+    for (int i = 0; i < m.numberOfCoefficients(); i++) {
+      result.setComplexAtIndex(i, compute(m.complexAtIndex(i), angleUnit).stdComplex());
     }
-    result.setDimensions(m.numberOfRows(), m.numberOfColumns());
     return result;
   }
 }
@@ -71,11 +70,10 @@ template<typename T> Evaluation<T> ApproximationHelper::MapReduce(const Expressi
 }
 
 template<typename T> MatrixComplex<T> ApproximationHelper::ElementWiseOnMatrixComplexAndComplex(const MatrixComplex<T> m, const std::complex<T> c, ComplexAndComplexReduction<T> computeOnComplexes) {
-  MatrixComplex<T> matrix;
-  for (int i = 0; i < m.numberOfChildren(); i++) {
-    matrix.addChildAtIndexInPlace(computeOnComplexes(m.complexAtIndex(i), c), i, i);
+  MatrixComplex<T> matrix(m.numberOfRows(), m.numberOfColumns());
+  for (int i = 0; i < m.numberOfCoefficients(); i++) {
+    matrix.setComplexAtIndex(i, computeOnComplexes(m.complexAtIndex(i), c).stdComplex());
   }
-  matrix.setDimensions(m.numberOfRows(), m.numberOfColumns());
   return matrix;
 }
 
@@ -83,11 +81,10 @@ template<typename T> MatrixComplex<T> ApproximationHelper::ElementWiseOnComplexM
   if (m.numberOfRows() != n.numberOfRows() || m.numberOfColumns() != n.numberOfColumns()) {
     return MatrixComplex<T>::Undefined();
   }
-  MatrixComplex<T> matrix;
-  for (int i = 0; i < m.numberOfChildren(); i++) {
-    matrix.addChildAtIndexInPlace(computeOnComplexes(m.complexAtIndex(i), n.complexAtIndex(i)), i, i);
+  MatrixComplex<T> matrix(m.numberOfRows(), m.numberOfColumns());
+  for (int i = 0; i < m.numberOfCoefficients(); i++) {
+    matrix.setComplexAtIndex(i, computeOnComplexes(m.complexAtIndex(i), n.complexAtIndex(i)).stdComplex());
   }
-  matrix.setDimensions(m.numberOfRows(), m.numberOfColumns());
   return matrix;
 }
 
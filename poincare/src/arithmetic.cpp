@@ -1,4 +1,7 @@
 #include <poincare/arithmetic.h>
+#include <poincare/expression.h>
+#include <assert.h>
+#include <string.h>
 #include <utility>
 
 namespace Poincare {
@@ -7,39 +10,329 @@ Integer Arithmetic::LCM(const Integer & a, const Integer & b) {
   if (a.isZero() || b.isZero()) {
     return Integer(0);
   }
-  Integer signResult = Integer::Division(Integer::Multiplication(a, b), GCD(a, b)).quotient;
+  // a/gcd(a,b) is exact, and dividing first keeps the product small
+  Integer signResult = Integer::Multiplication(Integer::Division(a, GCD(a, b)).quotient, b);
   signResult.setNegative(false);
   return signResult;
 }
 
+/* Binary GCD: the common powers of 2 are factored out, then the odd operands
+ * are reduced by subtraction. There is no division at all. */
+static uint64_t binaryGCD(uint64_t u, uint64_t v) {
+  if (u == 0) {
+    return v;
+  }
+  if (v == 0) {
+    return u;
+  }
+  int shift = __builtin_ctzll(u | v);
+  u >>= __builtin_ctzll(u);
+  do {
+    v >>= __builtin_ctzll(v);
+    if (u > v) {
+      std::swap(u, v);
+    }
+    v -= u;
+  } while (v != 0);
+  return u << shift;
+}
+
+static int numberOfSignificantDigits(const native_uint_t * digits, int numberOfDigits) {
+  while (numberOfDigits > 0 && digits[numberOfDigits-1] == 0) {
+    numberOfDigits--;
+  }
+  return numberOfDigits;
+}
+
+static uint64_t toUint64(const native_uint_t * digits, int numberOfDigits) {
+  assert(numberOfDigits <= 2);
+  uint64_t result = numberOfDigits > 0 ? digits[0] : 0;
+  if (numberOfDigits > 1) {
+    result |= (uint64_t)digits[1] << 32;
+  }
+  return result;
+}
+
+static Integer integerFromUint64(uint64_t value) {
+  native_uint_t digits[2] = {(native_uint_t)value, (native_uint_t)(value >> 32)};
+  return Integer::BuildInteger(digits, numberOfSignificantDigits(digits, 2), false);
+}
+
+static native_uint_t shortRemainder(const native_uint_t * u, int nu, native_uint_t v) {
+  uint64_t remainder = 0;
+  for (int i = nu-1; i >= 0; i--) {
+    remainder = ((remainder << 32) | u[i]) % v;
+  }
+  return remainder;
+}
+
+// u < v
+static bool isLower(const native_uint_t * u, int nu, const native_uint_t * v, int nv) {
+  if (nu != nv) {
+    return nu < nv;
+  }
+  for (int i = nu-1; i >= 0; i--) {
+    if (u[i] != v[i]) {
+      return u[i] < v[i];
+    }
+  }
+  return false;
+}
+
+/* r = x*u - y*v, which is known to be non-negative, with x, y < 2^32 so that
+ * no product overflows 64 bits. Returns the number of digits of r. */
+static int difference(uint64_t x, const native_uint_t * u, int nu, uint64_t y, const native_uint_t * v, int nv, native_uint_t * r) {
+  int n = nu > nv ? nu : nv;
+  uint64_t xCarry = 0;
+  uint64_t yCarry = 0;
+  int64_t borrow = 0;
+  for (int i = 0; i < n; i++) {
+    uint64_t p = (i < nu ? x*u[i] : 0) + xCarry;
+    uint64_t q = (i < nv ? y*v[i] : 0) + yCarry;
+    xCarry = p >> 32;
+    yCarry = q >> 32;
+    int64_t t = (int64_t)(native_uint_t)p - (int64_t)(native_uint_t)q - borrow;
+    r[i] = (native_uint_t)t;
+    borrow = t < 0;
+  }
+  assert(xCarry == yCarry + borrow);
+  return numberOfSignificantDigits(r, n);
+}
+
+// r = a*u + b*v, a and b having opposite signs or one of them being zero
+static int linearCombination(int64_t a, const native_uint_t * u, int nu, int64_t b, const native_uint_t * v, int nv, native_uint_t * r) {
+  if (b <= 0) {
+    return difference(a, u, nu, -b, v, nv, r);
+  }
+  return difference(b, v, nv, -a, u, nu, r);
+}
+
+/* Lehmer's algorithm (Knuth, TAOCP vol. 2, 4.5.2, Algorithm L): the steps of
+ * Euclid's algorithm are simulated on the leading 32 bits of the operands for
+ * as long as they give the same quotients as the full operands. The cofactors
+ * of the simulated steps are then applied to the full operands at once, which
+ * replaces a dozen divisions by two linear combinations. Operands which fit in
+ * 64 bits are handed over to the binary GCD. */
 Integer Arithmetic::GCD(const Integer & a, const Integer & b) {
   if (a.isInfinity() || b.isInfinity()) {
     return Integer::Overflow(false);
   }
-
-  Integer i = a;
-  Integer j = b;
-  i.setNegative(false);
-  j.setNegative(false);
-  do {
-    if (i.isZero()) {
-      return j;
+  native_uint_t buffers[4][Integer::k_maxNumberOfDigits];
+  native_uint_t * u = buffers[0];
+  native_uint_t * v = buffers[1];
+  native_uint_t * nextU = buffers[2];
+  native_uint_t * nextV = buffers[3];
+  int nu = a.numberOfDigits();
+  int nv = b.numberOfDigits();
+  memcpy(u, a.digits(), nu*sizeof(native_uint_t));
+  memcpy(v, b.digits(), nv*sizeof(native_uint_t));
+  if (isLower(u, nu, v, nv)) {
+    std::swap(u, v);
+    std::swap(nu, nv);
+  }
+  // Invariant: v <= u
+  while (nv > 0) {
+    if (nu <= 2) {
+      return integerFromUint64(binaryGCD(toUint64(u, nu), toUint64(v, nv)));
     }
-    if (j.isZero()) {
-      return i;
+    if (nv == 1) {
+      return integerFromUint64(binaryGCD(v[0], shortRemainder(u, nu, v[0])));
     }
-    if (Integer::NaturalOrder(i, j) > 0) {
-      i = Integer::Division(i, j).remainder;
-    } else {
-      j = Integer::Division(j, i).remainder;
+    // Leading 32 bits of u, and the bits of v at the same position
+    int shift = __builtin_clz(u[nu-1]);
+    int64_t uHat = (native_uint_t)((((uint64_t)u[nu-1] << 32) | u[nu-2]) >> (32-shift));
+    uint64_t vTop = nv == nu ? v[nu-1] : 0;
+    uint64_t vNext = nv >= nu-1 ? v[nu-2] : 0;
+    int64_t vHat = (native_uint_t)(((vTop << 32) | vNext) >> (32-shift));
+    int64_t A = 1, B = 0, C = 0, D = 1;
+    while (vHat + C != 0 && vHat + D != 0) {
+      int64_t q = (uHat + A)/(vHat + C);
+      if (q != (uHat + B)/(vHat + D)) {
+        break;
+      }
+      int64_t t = A - q*C;
+      A = C;
+      C = t;
+      t = B - q*D;
+      B = D;
+      D = t;
+      t = uHat - q*vHat;
+      uHat = vHat;
+      vHat = t;
     }
-  } while(true);
+    if (B == 0) {
+      /* The leading bits did not give a single quotient, which is too large:
+       * take a full step of Euclid's algorithm. */
+      Integer remainder = Integer::Division(Integer::BuildInteger(u, nu, false), Integer::BuildInteger(v, nv, false)).remainder;
+      std::swap(u, v);
+      nu = nv;
+      nv = remainder.numberOfDigits();
+      memcpy(v, remainder.digits(), nv*sizeof(native_uint_t));
+      continue;
+    }
+    int nextNu = linearCombination(A, u, nu, B, v, nv, nextU);
+    nv = linearCombination(C, u, nu, D, v, nv, nextV);
+    nu = nextNu;
+    std::swap(u, nextU);
+    std::swap(v, nextV);
+  }
+  return Integer::BuildInteger(u, nu, false);
 }
 
 int primeFactors[Arithmetic::k_numberOfPrimeFactors] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131, 137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 211, 223, 227, 229, 233, 239, 241, 251, 257, 263, 269, 271, 277, 281, 283, 293, 307, 311, 313, 317, 331, 337, 347, 349, 353, 359, 367, 373, 379, 383, 389, 397, 401, 409, 419, 421, 431, 433, 439, 443, 449, 457, 461, 463, 467, 479, 487, 491, 499, 503, 509, 521, 523, 541, 547, 557, 563, 569, 571, 577, 587, 593, 599, 601, 607, 613, 617, 619, 631, 641, 643, 647, 653, 659, 661, 673, 677, 683, 691, 701, 709, 719, 727, 733, 739, 743, 751, 757, 761, 769, 773, 787, 797, 809, 811, 821, 823, 827, 829, 839, 853, 857, 859, 863, 877, 881, 883, 887, 907, 911, 919, 929, 937, 941, 947, 953, 967, 971, 977, 983, 991, 997, 1009, 1013, 1019, 1021, 1031, 1033, 1039, 1049, 1051, 1061, 1063, 1069, 1087, 1091, 1093, 1097, 1103, 1109, 1117, 1123, 1129, 1151, 1153, 1163, 1171, 1181, 1187, 1193, 1201, 1213, 1217, 1223, 1229, 1231, 1237, 1249, 1259, 1277, 1279, 1283, 1289, 1291, 1297, 1301, 1303, 1307, 1319, 1321, 1327, 1361, 1367, 1373, 1381, 1399, 1409, 1423, 1427, 1429, 1433, 1439, 1447, 1451, 1453, 1459, 1471, 1481, 1483, 1487, 1489, 1493, 1499, 1511, 1523, 1531, 1543, 1549, 1553, 1559, 1567, 1571, 1579, 1583, 1597, 1601, 1607, 1609, 1613, 1619, 1621, 1627, 1637, 1657, 1663, 1667, 1669, 1693, 1697, 1699, 1709, 1721, 1723, 1733, 1741, 1747, 1753, 1759, 1777, 1783, 1787, 1789, 1801, 1811, 1823, 1831, 1847, 1861, 1867, 1871, 1873, 1877, 1879, 1889, 1901, 1907, 1913, 1931, 1933, 1949, 1951, 1973, 1979, 1987, 1993, 1997, 1999, 2003, 2011, 2017, 2027, 2029, 2039, 2053, 2063, 2069, 2081, 2083, 2087, 2089, 2099, 2111, 2113, 2129, 2131, 2137, 2141, 2143, 2153, 2161, 2179, 2203, 2207, 2213, 2221, 2237, 2239, 2243, 2251, 2267, 2269, 2273, 2281, 2287, 2293, 2297, 2309, 2311, 2333, 2339, 2341, 2347, 2351, 2357, 2371, 2377, 2381, 2383, 2389, 2393, 2399, 2411, 2417, 2423, 2437, 2441, 2447, 2459, 2467, 2473, 2477, 2503, 2521, 2531, 2539, 2543, 2549, 2551, 2557, 2579, 2591, 2593, 2609, 2617, 2621, 2633, 2647, 2657, 2659, 2663, 2671, 2677, 2683, 2687, 2689, 2693, 2699, 2707, 2711, 2713, 2719, 2729, 2731, 2741, 2749, 2753, 2767, 2777, 2789, 2791, 2797, 2801, 2803, 2819, 2833, 2837, 2843, 2851, 2857, 2861, 2879, 2887, 2897, 2903, 2909, 2917, 2927, 2939, 2953, 2957, 2963, 2969, 2971, 2999, 3001, 3011, 3019, 3023, 3037, 3041, 3049, 3061, 3067, 3079, 3083, 3089, 3109, 3119, 3121, 3137, 3163, 3167, 3169, 3181, 3187, 3191, 3203, 3209, 3217, 3221, 3229, 3251, 3253, 3257, 3259, 3271, 3299, 3301, 3307, 3313, 3319, 3323, 3329, 3331, 3343, 3347, 3359, 3361, 3371, 3373, 3389, 3391, 3407, 3413, 3433, 3449, 3457, 3461, 3463, 3467, 3469, 3491, 3499, 3511, 3517, 3527, 3529, 3533, 3539, 3541, 3547, 3557, 3559, 3571, 3581, 3583, 3593, 3607, 3613, 3617, 3623, 3631, 3637, 3643,
   3659, 3671, 3673, 3677, 3691, 3697, 3701, 3709, 3719, 3727, 3733, 3739, 3761, 3767, 3769, 3779, 3793, 3797, 3803, 3821, 3823, 3833, 3847, 3851, 3853, 3863, 3877, 3881, 3889, 3907, 3911, 3917, 3919, 3923, 3929, 3931, 3943, 3947, 3967, 3989, 4001, 4003, 4007, 4013, 4019, 4021, 4027, 4049, 4051, 4057, 4073, 4079, 4091, 4093, 4099, 4111, 4127, 4129, 4133, 4139, 4153, 4157, 4159, 4177, 4201, 4211, 4217, 4219, 4229, 4231, 4241, 4243, 4253, 4259, 4261, 4271, 4273, 4283, 4289, 4297, 4327, 4337, 4339, 4349, 4357, 4363, 4373, 4391, 4397, 4409, 4421, 4423, 4441, 4447, 4451, 4457, 4463, 4481, 4483, 4493, 4507, 4513, 4517, 4519, 4523, 4547, 4549, 4561, 4567, 4583, 4591, 4597, 4603, 4621, 4637, 4639, 4643, 4649, 4651, 4657, 4663, 4673, 4679, 4691, 4703, 4721, 4723, 4729, 4733, 4751, 4759, 4783, 4787, 4789, 4793, 4799, 4801, 4813, 4817, 4831, 4861, 4871, 4877, 4889, 4903, 4909, 4919, 4931, 4933, 4937, 4943, 4951, 4957, 4967, 4969, 4973, 4987, 4993, 4999, 5003, 5009, 5011, 5021, 5023, 5039, 5051, 5059, 5077, 5081, 5087, 5099, 5101, 5107, 5113, 5119, 5147, 5153, 5167, 5171, 5179, 5189, 5197, 5209, 5227, 5231, 5233, 5237, 5261, 5273, 5279, 5281, 5297, 5303, 5309, 5323, 5333, 5347, 5351, 5381, 5387, 5393, 5399, 5407, 5413, 5417, 5419, 5431, 5437, 5441, 5443, 5449, 5471, 5477, 5479, 5483, 5501, 5503, 5507, 5519, 5521, 5527, 5531, 5557, 5563, 5569, 5573, 5581, 5591, 5623, 5639, 5641, 5647, 5651, 5653, 5657, 5659, 5669, 5683, 5689, 5693, 5701, 5711, 5717, 5737, 5741, 5743, 5749, 5779, 5783, 5791, 5801, 5807, 5813, 5821, 5827, 5839, 5843, 5849, 5851, 5857, 5861, 5867, 5869, 5879, 5881, 5897, 5903, 5923, 5927, 5939, 5953, 5981, 5987, 6007, 6011, 6029, 6037, 6043, 6047, 6053, 6067, 6073, 6079, 6089, 6091, 6101, 6113, 6121, 6131, 6133, 6143, 6151, 6163, 6173, 6197, 6199, 6203, 6211, 6217, 6221, 6229, 6247, 6257, 6263, 6269, 6271, 6277, 6287, 6299, 6301, 6311, 6317, 6323, 6329, 6337, 6343, 6353, 6359, 6361, 6367, 6373, 6379, 6389, 6397, 6421, 6427, 6449, 6451, 6469, 6473, 6481, 6491, 6521, 6529, 6547, 6551, 6553, 6563, 6569, 6571, 6577, 6581, 6599, 6607, 6619, 6637, 6653, 6659, 6661, 6673, 6679, 6689, 6691, 6701, 6703, 6709, 6719, 6733, 6737, 6761, 6763, 6779, 6781, 6791, 6793, 6803, 6823, 6827, 6829, 6833, 6841, 6857, 6863, 6869, 6871, 6883, 6899, 6907, 6911, 6917, 6947, 6949, 6959, 6961, 6967, 6971, 6977, 6983, 6991, 6997, 7001, 7013, 7019, 7027, 7039, 7043, 7057, 7069, 7079, 7103, 7109, 7121, 7127, 7129, 7151, 7159, 7177, 7187, 7193, 7207, 7211, 7213, 7219, 7229, 7237, 7243, 7247, 7253, 7283, 7297, 7307, 7309, 7321, 7331, 7333, 7349, 7351, 7369, 7393, 7411, 7417, 7433, 7451, 7457, 7459, 7477, 7481, 7487, 7489, 7499, 7507, 7517, 7523, 7529, 7537, 7541, 7547, 7549, 7559, 7561, 7573, 7577, 7583, 7589, 7591, 7603, 7607, 7621, 7639, 7643, 7649, 7669, 7673, 7681, 7687, 7691, 7699, 7703, 7717, 7723, 7727, 7741, 7753, 7757, 7759, 7789, 7793, 7817, 7823, 7829, 7841, 7853, 7867, 7873, 7877, 7879, 7883, 7901, 7907, 7919};
 
-// we can go to 7907*7907 = 62 520 649
+static Integer modularMultiplication(const Integer & a, const Integer & b, const Integer & n) {
+  return Integer::Division(Integer::Multiplication(a, b), n).remainder;
+}
+
+// a^e mod n, by square-and-multiply on the bits of e
+static Integer modularPower(const Integer & a, const Integer & e, const Integer & n) {
+  Integer result(1);
+  for (int d = e.numberOfDigits()-1; d >= 0; d--) {
+    native_uint_t digit = e.digits()[d];
+    for (int b = 31; b >= 0; b--) {
+      result = modularMultiplication(result, result, n);
+      if ((digit >> b) & 1) {
+        result = modularMultiplication(result, a, n);
+      }
+    }
+  }
+  return result;
+}
+
+/* Miller-Rabin test with the first 13 primes as witnesses: it is
+ * deterministic below 3.3*10^24. Above, it is only probabilistic: with fixed
+ * witnesses, some composites pass it, and no error bound holds.
+ * n is odd and has no prime factor in primeFactors. */
+static bool isPrime(const Integer & n) {
+  Integer nMinusOne = Integer::Subtraction(n, Integer(1));
+  // n-1 = d*2^s with d odd
+  int s = 0;
+  Integer d = nMinusOne;
+  while (d.isEven()) {
+    d = Integer::Division(d, Integer(2)).quotient;
+    s++;
+  }
+  constexpr int k_numberOfWitnesses = 13;
+  for (int w = 0; w < k_numberOfWitnesses; w++) {
+    Integer x = modularPower(Integer(primeFactors[w]), d, n);
+    if (x.isOne() || x.isEqualTo(nMinusOne)) {
+      continue;
+    }
+    bool isWitness = true;
+    for (int r = 1; r < s && isWitness; r++) {
+      x = modularMultiplication(x, x, n);
+      isWitness = !x.isEqualTo(nMinusOne);
+    }
+    if (isWitness) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static Integer absoluteDifference(const Integer & a, const Integer & b) {
+  Integer difference = Integer::Subtraction(a, b);
+  difference.setNegative(false);
+  return difference;
+}
+
+// x^2+c mod n, the pseudorandom sequence of Pollard's rho
+static Integer pollardRhoStep(const Integer & x, const Integer & c, const Integer & n) {
+  return Integer::Division(Integer::Addition(Integer::Multiplication(x, x), c), n).remainder;
+}
+
+/* Pollard's rho algorithm with Brent's cycle detection: the differences are
+ * multiplied together so that a GCD is only computed every
+ * k_numberOfStepsPerGCD steps. n is composite. Each step of the sequence
+ * decrements numberOfStepsLeft and the search fails when it runs out, or when
+ * the circuit breaker asks to stop. */
+static bool pollardRhoDivisor(const Integer & n, Integer * divisor, int * numberOfStepsLeft) {
+  constexpr int k_numberOfStepsPerGCD = 64;
+  for (int i = 1; *numberOfStepsLeft > 0; i++) {
+    Integer c(i);
+    Integer x(2);
+    Integer y(2);
+    Integer ys(2);
+    Integer product(1);
+    Integer g(1);
+    for (int r = 1; g.isOne(); r *= 2) {
+      x = y;
+      for (int j = 0; j < r; j++) {
+        y = pollardRhoStep(y, c, n);
+      }
+      for (int k = 0; k < r && g.isOne(); k += k_numberOfStepsPerGCD) {
+        ys = y;
+        int numberOfSteps = r - k < k_numberOfStepsPerGCD ? r - k : k_numberOfStepsPerGCD;
+        for (int j = 0; j < numberOfSteps; j++) {
+          y = pollardRhoStep(y, c, n);
+          product = modularMultiplication(product, absoluteDifference(x, y), n);
+        }
+        g = Arithmetic::GCD(product, n);
+        *numberOfStepsLeft -= numberOfSteps;
+        if (*numberOfStepsLeft <= 0 || Expression::shouldStopProcessing()) {
+          return false;
+        }
+      }
+      *numberOfStepsLeft -= r;
+    }
+    if (g.isEqualTo(n)) {
+      // The product skipped over the divisor: retrace the last steps one by one
+      do {
+        ys = pollardRhoStep(ys, c, n);
+        g = Arithmetic::GCD(absoluteDifference(x, ys), n);
+      } while (g.isOne());
+    }
+    if (!g.isEqualTo(n)) {
+      *divisor = g;
+      return true;
+    }
+    // The sequence cycled without splitting n: try another c
+  }
+  return false;
+}
+
+/* m has no prime factor in primeFactors. Its prime factors are found by
+ * Miller-Rabin tests and Pollard's rho, and stored in no particular order in
+ * primes, with their multiplicities in coefficients. Returns the number of
+ * distinct prime factors, or -1 if it takes too many steps or if there are
+ * more than maxNumberOfPrimes of them. */
+static int largePrimeFactors(const Integer & m, Integer primes[], int coefficients[], int maxNumberOfPrimes) {
+  constexpr int k_maxNumberOfPollardRhoSteps = 50000;
+  int numberOfStepsLeft = k_maxNumberOfPollardRhoSteps;
+  Integer composites[Arithmetic::k_maxNumberOfPrimeFactors];
+  int numberOfComposites = 0;
+  int numberOfPrimes = 0;
+  composites[numberOfComposites++] = m;
+  while (numberOfComposites > 0) {
+    Integer c = composites[--numberOfComposites];
+    if (isPrime(c)) {
+      int i = 0;
+      while (i < numberOfPrimes && !primes[i].isEqualTo(c)) {
+        i++;
+      }
+      if (i == numberOfPrimes) {
+        if (numberOfPrimes == maxNumberOfPrimes) {
+          return -1;
+        }
+        primes[numberOfPrimes] = c;
+        coefficients[numberOfPrimes] = 0;
+        numberOfPrimes++;
+      }
+      coefficients[i]++;
+      continue;
+    }
+    Integer divisor;
+    if (numberOfComposites + 2 > Arithmetic::k_maxNumberOfPrimeFactors || !pollardRhoDivisor(c, &divisor, &numberOfStepsLeft)) {
+      return -1;
+    }
+    composites[numberOfComposites++] = Integer::Division(c, divisor).quotient;
+    composites[numberOfComposites++] = divisor;
+  }
+  return numberOfPrimes;
+}
+
 int Arithmetic::PrimeFactorization(const Integer & n, Integer outputFactors[], Integer outputCoefficients[], int outputLength) {
   assert(!n.isInfinity());
 
@@ -47,9 +340,6 @@ int Arithmetic::PrimeFactorization(const Integer & n, Integer outputFactors[], I
   Integer m = n;
   m.setNegative(false);
 
-  /* First we look for prime divisors in the table primeFactors (to speed up
-   * the prime factorization for low numbers). When k_numberOfPrimeFactors is
-   * overflow, try every number as divisor. */
   if (Integer::NaturalOrder(m, Integer(1)) == 0) {
     return 0;
   }
@@ -62,40 +352,74 @@ int Arithmetic::PrimeFactorization(const Integer & n, Integer outputFactors[], I
     return -1;
   }
 
+  /* First we look for prime divisors in the table primeFactors. The
+   * remainders are computed without building the quotients, which are only
+   * needed when a divisor is found. */
   int t = 0; // n prime factor index
-  int k = 0; // prime factor index
-  Integer testedPrimeFactor(primeFactors[k]); // prime factor
-  outputFactors[t] = testedPrimeFactor;
-  IntegerDivision d = {.quotient = 0, .remainder = 0};
-  bool stopCondition;
-  do {
-    stopCondition = Integer::NaturalOrder(Integer::Power(outputFactors[t], Integer(2)), m) < 0;
-    d = Integer::Division(m, testedPrimeFactor);
-    if (d.remainder.isZero()) {
-      outputCoefficients[t] = Integer::Addition(outputCoefficients[t], Integer(1));
-      m = d.quotient;
-      if (m.isOne()) {
-        return t+1;
-      }
-      continue;
+  bool mIsPrime = false;
+  for (int k = 0; k < k_numberOfPrimeFactors; k++) {
+    native_uint_t p = primeFactors[k];
+    if (Integer::NaturalOrder(Integer((native_int_t)(p*p)), m) > 0) {
+      // m has no prime factor below its square root: it is 1 or a prime
+      mIsPrime = !m.isOne();
+      break;
     }
-    if (!outputCoefficients[t].isZero()) {
-      t++;
+    if (shortRemainder(m.digits(), m.numberOfDigits(), p) != 0) {
+      continue;
     }
-    k++;
-    testedPrimeFactor = k < k_numberOfPrimeFactors ? Integer(primeFactors[k]) : Integer::Addition(testedPrimeFactor, Integer(1));
-    outputFactors[t] = testedPrimeFactor;
-  } while (stopCondition && Integer::NaturalOrder(testedPrimeFactor,Integer(k_biggestPrimeFactor)) < 0);
-  if (Integer::NaturalOrder(Integer::Power(Integer(k_biggestPrimeFactor), Integer(2)), m) < 0) {
+    Integer prime((native_int_t)p);
+    int coefficient = 0;
+    IntegerDivision d = Integer::Division(m, prime);
+    do {
+      coefficient++;
+      m = d.quotient;
+      d = Integer::Division(m, prime);
+    } while (d.remainder.isZero());
+    assert(t < outputLength);
+    outputFactors[t] = prime;
+    outputCoefficients[t] = Integer(coefficient);
+    t++;
+  }
+  if (m.isOne()) {
+    return t;
+  }
+  if (mIsPrime) {
+    assert(t < outputLength);
+    outputFactors[t] = m;
+    outputCoefficients[t] = Integer(1);
+    return t+1;
+  }
+
+  // The factors of m are above the table: split m with Pollard's rho
+  Integer primes[k_maxNumberOfPrimeFactors];
+  int coefficients[k_maxNumberOfPrimeFactors];
+  int maxNumberOfPrimes = outputLength - t < k_maxNumberOfPrimeFactors ? outputLength - t : k_maxNumberOfPrimeFactors;
+  int numberOfPrimes = largePrimeFactors(m, primes, coefficients, maxNumberOfPrimes);
+  if (numberOfPrimes < 0) {
     /* Special case 2: We do not want to break i in prime factor because it
-     * take too much time: the prime factor that should be tested is above
-     * k_biggestPrimeFactor.
+     * takes too much time or too many factors: Pollard's rho did not split
+     * one of its large factors within its budget, or the factors do not fit
+     * in the output.
      * outputCoefficients[0] is set to -1 to indicate a special case. */
     return -2;
   }
-  outputFactors[t] = m;
-  outputCoefficients[t] = Integer::Addition(outputCoefficients[t], Integer(1));
-  return t+1;
+  // Sort the large prime factors
+  for (int i = 1; i < numberOfPrimes; i++) {
+    for (int j = i; j > 0 && Integer::NaturalOrder(primes[j-1], primes[j]) > 0; j--) {
+      Integer tmp = primes[j];
+      primes[j] = primes[j-1];
+      primes[j-1] = tmp;
+      int tmpCoefficient = coefficients[j];
+      coefficients[j] = coefficients[j-1];
+      coefficients[j-1] = tmpCoefficient;
+    }
+  }
+  for (int i = 0; i < numberOfPrimes; i++) {
+    outputFactors[t] = primes[i];
+    outputCoefficients[t] = Integer(coefficients[i]);
+    t++;
+  }
+  return t;
 }
 
 }
@@ -0,0 +1,508 @@
+#include <poincare/compiled_expression.h>
+#include <poincare/complex.h>
+#include <poincare/symbol.h>
+#include <poincare/trigonometry.h>
+#include <ion.h>
+#include <cmath>
+extern "C" {
+#include <assert.h>
+}
+
+namespace Poincare {
+
+template<typename T>
+CompiledExpression<T>::CompiledExpression() :
+  m_expression(),
+  m_symbol(0),
+  m_angleUnit(Preferences::AngleUnit::Degree),
+  m_numberOfInstructions(0),
+  m_numberOfConstants(0),
+  m_numberOfSymbols(0),
+  m_symbols()
+{
+}
+
+template<typename T>
+CompiledExpression<T>::CompiledExpression(const Expression e, char symbol, Context & context, Preferences::AngleUnit angleUnit) :
+  m_expression(e),
+  m_symbol(symbol),
+  m_angleUnit(angleUnit),
+  m_numberOfInstructions(0),
+  m_numberOfConstants(0),
+  m_numberOfSymbols(0),
+  m_symbols()
+{
+  if (e.isUninitialized()) {
+    return;
+  }
+  int depth = 0;
+  if (!compile(e.node(), &depth, context)) {
+    // The expression will be approximated by walking the tree
+    m_numberOfInstructions = 0;
+    m_numberOfConstants = 0;
+    for (int i = 0; i < m_numberOfSymbols; i++) {
+      m_symbols[i] = Expression();
+    }
+    m_numberOfSymbols = 0;
+  }
+  assert(m_numberOfInstructions == 0 || depth == 1);
+}
+
+template<typename T>
+T CompiledExpression<T>::approximateWithValueForSymbol(T x, Context & context) const {
+  if (isUninitialized()) {
+    return NAN;
+  }
+  T result;
+  if (isCompiled() && run(x, context, &result)) {
+    return result;
+  }
+  return m_expression.approximateWithValueForSymbol(m_symbol, x, context, m_angleUnit);
+}
+
+template<typename T>
+void CompiledExpression<T>::approximateWithValuesForSymbol(const T * x, T * results, int numberOfValues, Context & context) const {
+  if (!isCompiled()) {
+    for (int i = 0; i < numberOfValues; i++) {
+      results[i] = approximateWithValueForSymbol(x[i], context);
+    }
+    return;
+  }
+  bool failed[k_batchSize];
+  for (int start = 0; start < numberOfValues; start += k_batchSize) {
+    int n = numberOfValues - start < k_batchSize ? numberOfValues - start : k_batchSize;
+    runBatch(x + start, n, context, results + start, failed);
+    for (int i = 0; i < n; i++) {
+      if (failed[i]) {
+        results[start+i] = m_expression.approximateWithValueForSymbol(m_symbol, x[start+i], context, m_angleUnit);
+      }
+    }
+  }
+}
+
+// Compilation
+
+template<typename T>
+bool CompiledExpression<T>::compile(const ExpressionNode * e, int * depth, Context & context) {
+  if (isConstant(e)) {
+    Evaluation<T> evaluation = e->approximate(T(), context, m_angleUnit);
+    if (evaluation.type() != EvaluationNode<T>::Type::Complex) {
+      return false;
+    }
+    Complex<T> c = static_cast<Complex<T> &>(evaluation);
+    if (c.imag() != 0 && !std::isnan(c.imag())) {
+      // The expression might be real (like (2i)^2) but we cannot tell
+      return false;
+    }
+    return pushConstant(c.imag() == 0 ? c.real() : NAN, depth);
+  }
+  OperationCode code;
+  switch (e->type()) {
+    case ExpressionNode::Type::Symbol:
+    {
+      const SymbolNode * symbol = static_cast<const SymbolNode *>(e);
+      if (symbol->name() == m_symbol) {
+        return pushInstruction(OperationCode::PushVariable, 0, 1, depth);
+      }
+      return pushSymbol(symbol, depth);
+    }
+    case ExpressionNode::Type::Parenthesis:
+      return compile(e->childAtIndex(0), depth, context);
+    case ExpressionNode::Type::Addition:
+    case ExpressionNode::Type::Multiplication:
+    {
+      /* Compile the n-ary operation as a left fold, in the same order as
+       * ApproximationHelper::MapReduce. */
+      code = e->type() == ExpressionNode::Type::Addition ? OperationCode::Addition : OperationCode::Multiplication;
+      if (!compile(e->childAtIndex(0), depth, context)) {
+        return false;
+      }
+      for (int i = 1; i < e->numberOfChildren(); i++) {
+        if (!compile(e->childAtIndex(i), depth, context) || !pushInstruction(code, 0, -1, depth)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case ExpressionNode::Type::Subtraction:
+      code = OperationCode::Subtraction;
+      break;
+    case ExpressionNode::Type::Division:
+      code = OperationCode::Division;
+      break;
+    case ExpressionNode::Type::Power:
+      code = OperationCode::Power;
+      break;
+    case ExpressionNode::Type::NthRoot:
+      code = OperationCode::NthRoot;
+      break;
+    case ExpressionNode::Type::Logarithm:
+      code = e->numberOfChildren() == 2 ? OperationCode::LogarithmWithBase : OperationCode::Logarithm;
+      break;
+    case ExpressionNode::Type::Opposite:
+      code = OperationCode::Opposite;
+      break;
+    case ExpressionNode::Type::AbsoluteValue:
+      code = OperationCode::AbsoluteValue;
+      break;
+    case ExpressionNode::Type::SquareRoot:
+      code = OperationCode::SquareRoot;
+      break;
+    case ExpressionNode::Type::NaperianLogarithm:
+      code = OperationCode::NaperianLogarithm;
+      break;
+    case ExpressionNode::Type::Sine:
+      code = OperationCode::Sine;
+      break;
+    case ExpressionNode::Type::Cosine:
+      code = OperationCode::Cosine;
+      break;
+    case ExpressionNode::Type::Tangent:
+      code = OperationCode::Tangent;
+      break;
+    case ExpressionNode::Type::ArcSine:
+      code = OperationCode::ArcSine;
+      break;
+    case ExpressionNode::Type::ArcCosine:
+      code = OperationCode::ArcCosine;
+      break;
+    case ExpressionNode::Type::ArcTangent:
+      code = OperationCode::ArcTangent;
+      break;
+    case ExpressionNode::Type::HyperbolicSine:
+      code = OperationCode::HyperbolicSine;
+      break;
+    case ExpressionNode::Type::HyperbolicCosine:
+      code = OperationCode::HyperbolicCosine;
+      break;
+    case ExpressionNode::Type::HyperbolicTangent:
+      code = OperationCode::HyperbolicTangent;
+      break;
+    case ExpressionNode::Type::Floor:
+      code = OperationCode::Floor;
+      break;
+    case ExpressionNode::Type::Ceiling:
+      code = OperationCode::Ceiling;
+      break;
+    case ExpressionNode::Type::FracPart:
+      code = OperationCode::FracPart;
+      break;
+    default:
+      return false;
+  }
+  // Unary and binary operations: operands first, then the operation
+  int numberOfChildren = e->numberOfChildren();
+  assert(numberOfChildren == 1 || numberOfChildren == 2);
+  for (int i = 0; i < numberOfChildren; i++) {
+    if (!compile(e->childAtIndex(i), depth, context)) {
+      return false;
+    }
+  }
+  return pushInstruction(code, 0, 1-numberOfChildren, depth);
+}
+
+template<typename T>
+bool CompiledExpression<T>::isConstant(const ExpressionNode * e) const {
+  /* An expression is constant if it only holds the symbols which do not
+   * depend on the context (π, e and i) and no random function. */
+  if (e->type() == ExpressionNode::Type::Random || e->type() == ExpressionNode::Type::Randint) {
+    return false;
+  }
+  if (e->type() == ExpressionNode::Type::Symbol) {
+    char name = static_cast<const SymbolNode *>(e)->name();
+    return name == Ion::Charset::SmallPi || name == Ion::Charset::Exponential || name == Ion::Charset::IComplex;
+  }
+  for (int i = 0; i < e->numberOfChildren(); i++) {
+    if (!isConstant(e->childAtIndex(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template<typename T>
+bool CompiledExpression<T>::pushConstant(T value, int * depth) {
+  if (m_numberOfConstants >= k_maxNumberOfConstants) {
+    return false;
+  }
+  m_constants[m_numberOfConstants] = value;
+  return pushInstruction(OperationCode::PushConstant, m_numberOfConstants++, 1, depth);
+}
+
+template<typename T>
+bool CompiledExpression<T>::pushSymbol(const SymbolNode * symbol, int * depth) {
+  if (m_numberOfSymbols >= k_maxNumberOfSymbols) {
+    return false;
+  }
+  m_symbols[m_numberOfSymbols] = Symbol(symbol);
+  return pushInstruction(OperationCode::PushSymbol, m_numberOfSymbols++, 1, depth);
+}
+
+template<typename T>
+bool CompiledExpression<T>::pushInstruction(OperationCode code, uint8_t operand, int stackDelta, int * depth) {
+  *depth += stackDelta;
+  if (m_numberOfInstructions >= k_maxNumberOfInstructions || *depth > k_maxStackDepth) {
+    return false;
+  }
+  assert(*depth > 0);
+  m_instructions[m_numberOfInstructions++] = {.code = code, .operand = operand};
+  return true;
+}
+
+// Approximation
+
+template<typename T>
+bool CompiledExpression<T>::run(T x, Context & context, T * result) const {
+  T stack[k_maxStackDepth];
+  int depth = 0;
+  for (int i = 0; i < m_numberOfInstructions; i++) {
+    const Instruction & instruction = m_instructions[i];
+    switch (instruction.code) {
+      case OperationCode::PushConstant:
+        stack[depth++] = m_constants[instruction.operand];
+        break;
+      case OperationCode::PushSymbol:
+        stack[depth++] = m_symbols[instruction.operand].template approximateToScalar<T>(context, m_angleUnit);
+        break;
+      case OperationCode::PushVariable:
+        stack[depth++] = x;
+        break;
+      case OperationCode::Addition:
+      case OperationCode::Subtraction:
+      case OperationCode::Multiplication:
+      case OperationCode::Division:
+      case OperationCode::Power:
+      case OperationCode::NthRoot:
+      case OperationCode::LogarithmWithBase:
+        depth--;
+        if (!computeBinary(instruction.code, stack[depth-1], stack[depth], &stack[depth-1])) {
+          return false;
+        }
+        break;
+      default:
+        if (!computeUnary(instruction.code, stack[depth-1], m_angleUnit, &stack[depth-1])) {
+          return false;
+        }
+    }
+    /* Infinite and undefined values are left to the tree approximation, which
+     * handles them in the complex plane. */
+    if (!std::isfinite(stack[depth-1])) {
+      return false;
+    }
+  }
+  assert(depth == 1);
+  *result = stack[0];
+  return true;
+}
+
+template<typename T>
+void CompiledExpression<T>::runBatch(const T * x, int n, Context & context, T * results, bool * failed) const {
+  T stack[k_maxStackDepth][k_batchSize];
+  int depth = 0;
+  for (int j = 0; j < n; j++) {
+    failed[j] = false;
+  }
+  for (int i = 0; i < m_numberOfInstructions; i++) {
+    const Instruction & instruction = m_instructions[i];
+    T * a;
+    const T * b;
+    switch (instruction.code) {
+      case OperationCode::PushConstant:
+      case OperationCode::PushSymbol:
+      {
+        T value = instruction.code == OperationCode::PushConstant ? m_constants[instruction.operand] : m_symbols[instruction.operand].template approximateToScalar<T>(context, m_angleUnit);
+        for (int j = 0; j < n; j++) {
+          stack[depth][j] = value;
+        }
+        depth++;
+        break;
+      }
+      case OperationCode::PushVariable:
+        for (int j = 0; j < n; j++) {
+          stack[depth][j] = x[j];
+        }
+        depth++;
+        break;
+      case OperationCode::Addition:
+        b = stack[--depth];
+        a = stack[depth-1];
+        for (int j = 0; j < n; j++) {
+          a[j] += b[j];
+        }
+        break;
+      case OperationCode::Subtraction:
+        b = stack[--depth];
+        a = stack[depth-1];
+        for (int j = 0; j < n; j++) {
+          a[j] -= b[j];
+        }
+        break;
+      case OperationCode::Multiplication:
+        b = stack[--depth];
+        a = stack[depth-1];
+        for (int j = 0; j < n; j++) {
+          a[j] *= b[j];
+        }
+        break;
+      case OperationCode::Division:
+        b = stack[--depth];
+        a = stack[depth-1];
+        for (int j = 0; j < n; j++) {
+          a[j] /= b[j];
+        }
+        break;
+      case OperationCode::Opposite:
+        a = stack[depth-1];
+        for (int j = 0; j < n; j++) {
+          a[j] = -a[j];
+        }
+        break;
+      case OperationCode::Power:
+      case OperationCode::NthRoot:
+      case OperationCode::LogarithmWithBase:
+        b = stack[--depth];
+        a = stack[depth-1];
+        for (int j = 0; j < n; j++) {
+          failed[j] = !computeBinary(instruction.code, a[j], b[j], &a[j]) || failed[j];
+        }
+        break;
+      default:
+        a = stack[depth-1];
+        for (int j = 0; j < n; j++) {
+          failed[j] = !computeUnary(instruction.code, a[j], m_angleUnit, &a[j]) || failed[j];
+        }
+    }
+    a = stack[depth-1];
+    for (int j = 0; j < n; j++) {
+      failed[j] = !std::isfinite(a[j]) || failed[j];
+    }
+  }
+  assert(depth == 1);
+  for (int j = 0; j < n; j++) {
+    results[j] = stack[0][j];
+  }
+}
+
+template<typename T>
+bool CompiledExpression<T>::computeBinary(OperationCode code, T a, T b, T * result) {
+  switch (code) {
+    case OperationCode::Addition:
+      *result = a+b;
+      return true;
+    case OperationCode::Subtraction:
+      *result = a-b;
+      return true;
+    case OperationCode::Multiplication:
+      *result = a*b;
+      return true;
+    case OperationCode::Division:
+      *result = a/b;
+      return true;
+    case OperationCode::Power:
+      // A negative number to a non-integer power is complex
+      if (a < 0 && b != std::round(b)) {
+        return false;
+      }
+      if (a == 0) {
+        return false;
+      }
+      *result = std::pow(a, b);
+      return true;
+    case OperationCode::NthRoot:
+      if (a <= 0) {
+        return false;
+      }
+      *result = std::pow(a, 1/b);
+      return true;
+    default:
+      assert(code == OperationCode::LogarithmWithBase);
+      if (a <= 0 || b <= 0) {
+        return false;
+      }
+      *result = std::log10(a)/std::log10(b);
+      return true;
+  }
+}
+
+template<typename T>
+bool CompiledExpression<T>::computeUnary(OperationCode code, T a, Preferences::AngleUnit angleUnit, T * result) {
+  /* These mirror the computeOnComplex methods of the corresponding nodes on
+   * the real line, including the conversion of angles and the rounding of
+   * trigonometric results. */
+  T angleToRadian = angleUnit == Preferences::AngleUnit::Degree ? (T)(M_PI/180.0) : 1;
+  T radianToAngle = angleUnit == Preferences::AngleUnit::Degree ? (T)(180/M_PI) : 1;
+  switch (code) {
+    case OperationCode::Opposite:
+      *result = -a;
+      return true;
+    case OperationCode::AbsoluteValue:
+      *result = std::fabs(a);
+      return true;
+    case OperationCode::SquareRoot:
+      if (a < 0) {
+        return false;
+      }
+      *result = std::sqrt(a);
+      return true;
+    case OperationCode::NaperianLogarithm:
+      if (a <= 0) {
+        return false;
+      }
+      *result = std::log(a);
+      return true;
+    case OperationCode::Logarithm:
+      if (a <= 0) {
+        return false;
+      }
+      *result = std::log10(a);
+      return true;
+    case OperationCode::Sine:
+      *result = Trigonometry::RoundToMeaningfulDigits(std::sin(a*angleToRadian));
+      return true;
+    case OperationCode::Cosine:
+      *result = Trigonometry::RoundToMeaningfulDigits(std::cos(a*angleToRadian));
+      return true;
+    case OperationCode::Tangent:
+      *result = Trigonometry::RoundToMeaningfulDigits(std::tan(a*angleToRadian));
+      return true;
+    case OperationCode::ArcSine:
+      if (a < -1 || a > 1) {
+        return false;
+      }
+      *result = Trigonometry::RoundToMeaningfulDigits(std::asin(a))*radianToAngle;
+      return true;
+    case OperationCode::ArcCosine:
+      if (a < -1 || a > 1) {
+        return false;
+      }
+      *result = Trigonometry::RoundToMeaningfulDigits(std::acos(a))*radianToAngle;
+      return true;
+    case OperationCode::ArcTangent:
+      *result = Trigonometry::RoundToMeaningfulDigits(std::atan(a))*radianToAngle;
+      return true;
+    case OperationCode::HyperbolicSine:
+      *result = Trigonometry::RoundToMeaningfulDigits(std::sinh(a));
+      return true;
+    case OperationCode::HyperbolicCosine:
+      *result = Trigonometry::RoundToMeaningfulDigits(std::cosh(a));
+      return true;
+    case OperationCode::HyperbolicTangent:
+      *result = Trigonometry::RoundToMeaningfulDigits(std::tanh(a));
+      return true;
+    case OperationCode::Floor:
+      *result = std::floor(a);
+      return true;
+    case OperationCode::Ceiling:
+      *result = std::ceil(a);
+      return true;
+    default:
+      assert(code == OperationCode::FracPart);
+      *result = a-std::floor(a);
+      return true;
+  }
+}
+
+template class CompiledExpression<float>;
+template class CompiledExpression<double>;
+
+}
@@ -42,34 +42,39 @@ T ComplexNode<T>::toScalar() const {
 
 template<typename T>
 Expression ComplexNode<T>::complexToExpression(Preferences::ComplexFormat complexFormat) const {
-  if (std::isnan(this->real()) || std::isnan(this->imag())) {
+  return ComplexToExpression(*this, complexFormat);
+}
+
+template<typename T>
+Expression ComplexNode<T>::ComplexToExpression(std::complex<T> c, Preferences::ComplexFormat complexFormat) {
+  if (std::isnan(c.real()) || std::isnan(c.imag())) {
     return Undefined();
   }
   if (complexFormat == Preferences::ComplexFormat::Cartesian) {
       Expression real;
       Expression imag;
-      if (this->real() != 0 || this->imag() == 0) {
-        real = Number::DecimalNumber<T>(this->real());
+      if (c.real() != 0 || c.imag() == 0) {
+        real = Number::DecimalNumber<T>(c.real());
       }
-      if (this->imag() != 0) {
-        if (this->imag() == 1.0 || this->imag() == -1) {
+      if (c.imag() != 0) {
+        if (c.imag() == 1.0 || c.imag() == -1) {
           imag = Symbol(Ion::Charset::IComplex);
-        } else if (this->imag() > 0) {
-          imag = Multiplication(Number::DecimalNumber(this->imag()), Symbol(Ion::Charset::IComplex));
+        } else if (c.imag() > 0) {
+          imag = Multiplication(Number::DecimalNumber(c.imag()), Symbol(Ion::Charset::IComplex));
         } else {
-          imag = Multiplication(Number::DecimalNumber(-this->imag()), Symbol(Ion::Charset::IComplex));
+          imag = Multiplication(Number::DecimalNumber(-c.imag()), Symbol(Ion::Charset::IComplex));
         }
       }
       if (imag.isUninitialized()) {
         return real;
       } else if (real.isUninitialized()) {
-        if (this->imag() > 0) {
+        if (c.imag() > 0) {
           return imag;
         } else {
           return Opposite(imag);
         }
         return imag;
-      } else if (this->imag() > 0) {
+      } else if (c.imag() > 0) {
         return Addition(real, imag);
       } else {
         return Subtraction(real, imag);
@@ -78,8 +83,8 @@ Expression ComplexNode<T>::complexToExpression(Preferences::ComplexFormat comple
   assert(complexFormat == Preferences::ComplexFormat::Polar);
   Expression norm;
   Expression exp;
-  T r = std::abs(*this);
-  T th = std::arg(*this);
+  T r = std::abs(c);
+  T th = std::arg(c);
   if (r != 1 || th == 0) {
     norm = Number::DecimalNumber(r);
   }
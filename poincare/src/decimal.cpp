@@ -70,6 +70,14 @@ int DecimalNode::simplificationOrderSameType(const ExpressionNode * e, bool canB
   return ((int)sign())*unsignedComparison;
 }
 
+uint8_t DecimalNode::computeStructuralHash() const {
+  // Decimals are rare in reduced expressions: the mantissa is left out
+  uint32_t hash = CombineHash(2166136261, static_cast<uint32_t>(type()));
+  hash = CombineHash(hash, m_negative);
+  hash = CombineHash(hash, m_exponent);
+  return FoldHash(hash);
+}
+
 Expression DecimalNode::shallowReduce(Context & context, Preferences::AngleUnit angleUnit) {
   return Decimal(this).shallowReduce(context, angleUnit);
 }
@@ -2,10 +2,11 @@
 
 namespace Poincare {
 
-ExceptionCheckpoint * ExceptionCheckpoint::s_topmostExceptionCheckpoint;
+POINCARE_THREAD_LOCAL ExceptionCheckpoint * ExceptionCheckpoint::s_topmostExceptionCheckpoint;
 
 ExceptionCheckpoint::ExceptionCheckpoint() :
   m_endOfPoolBeforeCheckpoint(TreePool::sharedPool()->last()),
+  m_integerDigitsBeforeCheckpoint(IntegerDigitArena::TakeSnapshot()),
   m_parent(s_topmostExceptionCheckpoint)
 {
   s_topmostExceptionCheckpoint = this;
@@ -22,6 +23,7 @@ int ExceptionCheckpoint::run() {
 
 void ExceptionCheckpoint::rollback() {
   Poincare::TreePool::sharedPool()->freePoolFromNode(m_endOfPoolBeforeCheckpoint);
+  IntegerDigitArena::Rollback(m_integerDigitsBeforeCheckpoint);
   longjmp(m_jumpBuffer, 1);
 }
 
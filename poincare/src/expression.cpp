@@ -1,9 +1,11 @@
 #include <poincare/expression.h>
+#include <poincare/compiled_expression.h>
 #include <poincare/expression_node.h>
 #include <poincare/rational.h>
 #include <poincare/opposite.h>
 #include <poincare/undefined.h>
 #include <poincare/symbol.h>
+#include <poincare/thread_local.h>
 #include <poincare/variable_context.h>
 #include <ion.h>
 #include <cmath>
@@ -13,7 +15,7 @@
 #include "expression_parser.hpp"
 #include "expression_lexer.hpp"
 
-int poincare_expression_yyparse(Poincare::Expression * expressionOutput);
+int poincare_expression_yyparse(Poincare::Expression * expressionOutput, void * scanner);
 
 namespace Poincare {
 
@@ -28,24 +30,30 @@ Expression Expression::parse(char const * string) {
     return Expression();
   }
 
-  static YY_BUFFER_STATE buf = nullptr;
-  if (buf != nullptr) {
-     poincare_expression_yy_delete_buffer(buf);
+  /* The state of the lexer lives in a scanner of the calling thread. If an
+   * exception interrupted the previous parsing, its scanner is destroyed
+   * here. */
+  static POINCARE_THREAD_LOCAL yyscan_t scanner = nullptr;
+  if (scanner != nullptr) {
+    poincare_expression_yylex_destroy(scanner);
   }
-  buf = poincare_expression_yy_scan_string(string);
+  poincare_expression_yylex_init(&scanner);
+  poincare_expression_yy_scan_string(string, scanner);
 
   Expression expression;
-  if (poincare_expression_yyparse(&expression) != 0) {
+  if (poincare_expression_yyparse(&expression, scanner) != 0) {
     // Parsing failed because of invalid input or memory exhaustion
     expression = Expression();
   }
+  poincare_expression_yylex_destroy(scanner);
+  scanner = nullptr;
   return expression;
 }
 
 /* Circuit breaker */
 
-static Expression::CircuitBreaker sCircuitBreaker = nullptr;
-static bool sSimplificationHasBeenInterrupted = false;
+static POINCARE_THREAD_LOCAL Expression::CircuitBreaker sCircuitBreaker = nullptr;
+static POINCARE_THREAD_LOCAL bool sSimplificationHasBeenInterrupted = false;
 
 void Expression::setCircuitBreaker(CircuitBreaker cb) {
   sCircuitBreaker = cb;
@@ -208,12 +216,41 @@ int Expression::getPolynomialReducedCoefficients(char symbolName, Expression coe
 
 /* Comparison */
 
+#if DEBUG
+static POINCARE_THREAD_LOCAL int sNumberOfIdentityTests = 0;
+static POINCARE_THREAD_LOCAL int sNumberOfAvoidedComparisons = 0;
+#endif
+
 bool Expression::isIdenticalTo(const Expression e) const {
+#if DEBUG
+  sNumberOfIdentityTests++;
+#endif
+  if (node()->structuralHash() != e.node()->structuralHash()) {
+#if DEBUG
+    sNumberOfAvoidedComparisons++;
+#endif
+    return false;
+  }
   /* We use the simplification order only because it is a already-coded total
    * order on expresssions. */
   return ExpressionNode::SimplificationOrder(node(), e.node(), true) == 0;
 }
 
+#if DEBUG
+int Expression::NumberOfIdentityTests() {
+  return sNumberOfIdentityTests;
+}
+
+int Expression::NumberOfAvoidedComparisons() {
+  return sNumberOfAvoidedComparisons;
+}
+
+void Expression::ResetIdentityTestsStatistics() {
+  sNumberOfIdentityTests = 0;
+  sNumberOfAvoidedComparisons = 0;
+}
+#endif
+
 bool Expression::isEqualToItsApproximationLayout(Expression approximation, char * buffer, int bufferSize, Preferences::AngleUnit angleUnit, Preferences::PrintFloatMode floatDisplayMode, int numberOfSignificantDigits, Context & context) {
   approximation.serialize(buffer, bufferSize, floatDisplayMode, numberOfSignificantDigits);
   /* Warning: we cannot use directly the the approximate expression but we have
@@ -313,6 +350,11 @@ U Expression::approximateWithValueForSymbol(char symbol, U x, Context & context,
   return approximateToScalar<U>(variableContext, angleUnit);
 }
 
+template<typename U>
+void Expression::approximateWithValuesForSymbol(char symbol, const U * x, U * results, int numberOfValues, Context & context, Preferences::AngleUnit angleUnit) const {
+  CompiledExpression<U>(*this, symbol, context, angleUnit).approximateWithValuesForSymbol(x, results, numberOfValues, context);
+}
+
 template<typename U>
 U Expression::epsilon() {
   static U epsilon = sizeof(U) == sizeof(double) ? 1E-15 : 1E-7f;
@@ -322,36 +364,51 @@ U Expression::epsilon() {
 /* Expression roots/extrema solver*/
 
 typename Expression::Coordinate2D Expression::nextMinimum(char symbol, double start, double step, double max, Context & context, Preferences::AngleUnit angleUnit) const {
-  return nextMinimumOfExpression(symbol, start, step, max, [](char symbol, double x, Context & context, Preferences::AngleUnit angleUnit, const Expression expression0, const Expression expression1 = Expression()) {
-        return expression0.approximateWithValueForSymbol(symbol, x, context, angleUnit);
-      }, context, angleUnit);
+  return nextMinimumOfExpression(start, step, max, [](double x, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1) {
+        return expression0.approximateWithValueForSymbol(x, context);
+      }, context, CompiledExpression<double>(*this, symbol, context, angleUnit), CompiledExpression<double>());
 }
 
 typename Expression::Coordinate2D Expression::nextMaximum(char symbol, double start, double step, double max, Context & context, Preferences::AngleUnit angleUnit) const {
-  Coordinate2D minimumOfOpposite = nextMinimumOfExpression(symbol, start, step, max, [](char symbol, double x, Context & context, Preferences::AngleUnit angleUnit, const Expression expression0, const Expression expression1 = Expression()) {
-        return -expression0.approximateWithValueForSymbol(symbol, x, context, angleUnit);
-      }, context, angleUnit);
+  Coordinate2D minimumOfOpposite = nextMinimumOfExpression(start, step, max, [](double x, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1) {
+        return -expression0.approximateWithValueForSymbol(x, context);
+      }, context, CompiledExpression<double>(*this, symbol, context, angleUnit), CompiledExpression<double>());
   return {.abscissa = minimumOfOpposite.abscissa, .value = -minimumOfOpposite.value};
 }
 
 double Expression::nextRoot(char symbol, double start, double step, double max, Context & context, Preferences::AngleUnit angleUnit) const {
-  return nextIntersectionWithExpression(symbol, start, step, max, [](char symbol, double x, Context & context, Preferences::AngleUnit angleUnit, const Expression expression0, const Expression expression1 = Expression()) {
-        return expression0.approximateWithValueForSymbol(symbol, x, context, angleUnit);
-      }, context, angleUnit, nullptr);
+  return nextIntersectionWithExpression(start, step, max, context, CompiledExpression<double>(*this, symbol, context, angleUnit), CompiledExpression<double>());
+}
+
+int Expression::nextRoots(char symbol, double start, double step, double max, double * roots, int maxNumberOfRoots, Context & context, Preferences::AngleUnit angleUnit) const {
+  return nextIntersectionsWithExpression(start, step, max, roots, maxNumberOfRoots, context, CompiledExpression<double>(*this, symbol, context, angleUnit), CompiledExpression<double>());
 }
 
 typename Expression::Coordinate2D Expression::nextIntersection(char symbol, double start, double step, double max, Poincare::Context & context, Preferences::AngleUnit angleUnit, const Expression expression) const {
-  double resultAbscissa = nextIntersectionWithExpression(symbol, start, step, max, [](char symbol, double x, Context & context, Preferences::AngleUnit angleUnit, const Expression expression0, const Expression expression1) {
-        return expression0.approximateWithValueForSymbol(symbol, x, context, angleUnit)-expression1.approximateWithValueForSymbol(symbol, x, context, angleUnit);
-      }, context, angleUnit, expression);
-  typename Expression::Coordinate2D result = {.abscissa = resultAbscissa, .value = approximateWithValueForSymbol(symbol, resultAbscissa, context, angleUnit)};
+  CompiledExpression<double> compiledExpression0(*this, symbol, context, angleUnit);
+  double resultAbscissa = nextIntersectionWithExpression(start, step, max, context, compiledExpression0, CompiledExpression<double>(expression, symbol, context, angleUnit));
+  typename Expression::Coordinate2D result = {.abscissa = resultAbscissa, .value = compiledExpression0.approximateWithValueForSymbol(resultAbscissa, context)};
   if (std::fabs(result.value) < step*k_solverPrecision) {
     result.value = 0.0;
   }
   return result;
 }
 
-typename Expression::Coordinate2D Expression::nextMinimumOfExpression(char symbol, double start, double step, double max, EvaluationAtAbscissa evaluate, Context & context, Preferences::AngleUnit angleUnit, const Expression expression, bool lookForRootMinimum) const {
+double Expression::evaluateDifference(double x, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1) {
+  if (expression1.isUninitialized()) {
+    return expression0.approximateWithValueForSymbol(x, context);
+  }
+  return expression0.approximateWithValueForSymbol(x, context)-expression1.approximateWithValueForSymbol(x, context);
+}
+
+double Expression::evaluateOppositeOfDifference(double x, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1) {
+  if (expression1.isUninitialized()) {
+    return -expression0.approximateWithValueForSymbol(x, context);
+  }
+  return expression1.approximateWithValueForSymbol(x, context)-expression0.approximateWithValueForSymbol(x, context);
+}
+
+typename Expression::Coordinate2D Expression::nextMinimumOfExpression(double start, double step, double max, EvaluationAtAbscissa evaluate, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1, bool lookForRootMinimum) {
   Coordinate2D result = {.abscissa = NAN, .value = NAN};
   if (start == max || step == 0.0) {
     return result;
@@ -360,13 +417,13 @@ typename Expression::Coordinate2D Expression::nextMinimumOfExpression(char symbo
   double x = start;
   bool endCondition = false;
   do {
-    bracketMinimum(symbol, x, step, max, bracket, evaluate, context, angleUnit, expression);
-    result = brentMinimum(symbol, bracket[0], bracket[2], evaluate, context, angleUnit, expression);
+    bracketMinimum(x, step, max, bracket, evaluate, context, expression0, expression1);
+    result = brentMinimum(bracket[0], bracket[2], evaluate, context, expression0, expression1);
     x = bracket[1];
     // Because of float approximation, exact zero is never reached
     if (std::fabs(result.abscissa) < std::fabs(step)*k_solverPrecision) {
       result.abscissa = 0;
-      result.value = evaluate(symbol, 0, context, angleUnit, *this, expression);
+      result.value = evaluate(0, context, expression0, expression1);
     }
     /* Ignore extremum whose value is undefined or too big because they are
      * really unlikely to be local extremum. */
@@ -388,13 +445,13 @@ typename Expression::Coordinate2D Expression::nextMinimumOfExpression(char symbo
   return result;
 }
 
-void Expression::bracketMinimum(char symbol, double start, double step, double max, double result[3], EvaluationAtAbscissa evaluate, Context & context, Preferences::AngleUnit angleUnit, const Expression expression) const {
+void Expression::bracketMinimum(double start, double step, double max, double result[3], EvaluationAtAbscissa evaluate, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1) {
   Coordinate2D p[3];
-  p[0] = {.abscissa = start, .value = evaluate(symbol, start, context, angleUnit, *this, expression)};
-  p[1] = {.abscissa = start+step, .value = evaluate(symbol, start+step, context, angleUnit, *this, expression)};
+  p[0] = {.abscissa = start, .value = evaluate(start, context, expression0, expression1)};
+  p[1] = {.abscissa = start+step, .value = evaluate(start+step, context, expression0, expression1)};
   double x = start+2.0*step;
   while (step > 0.0 ? x <= max : x >= max) {
-    p[2] = {.abscissa = x, .value = evaluate(symbol, x, context, angleUnit, *this, expression)};
+    p[2] = {.abscissa = x, .value = evaluate(x, context, expression0, expression1)};
     if ((p[0].value > p[1].value || std::isnan(p[0].value)) && (p[2].value > p[1].value || std::isnan(p[2].value)) && (!std::isnan(p[0].value) || !std::isnan(p[2].value))) {
       result[0] = p[0].abscissa;
       result[1] = p[1].abscissa;
@@ -413,11 +470,11 @@ void Expression::bracketMinimum(char symbol, double start, double step, double m
   result[2] = NAN;
 }
 
-typename Expression::Coordinate2D Expression::brentMinimum(char symbol, double ax, double bx, EvaluationAtAbscissa evaluate, Context & context, Preferences::AngleUnit angleUnit, const Expression expression) const {
+typename Expression::Coordinate2D Expression::brentMinimum(double ax, double bx, EvaluationAtAbscissa evaluate, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1) {
   /* Bibliography: R. P. Brent, Algorithms for finding zeros and extrema of
    * functions without calculating derivatives */
   if (ax > bx) {
-    return brentMinimum(symbol, bx, ax, evaluate, context, angleUnit, expression);
+    return brentMinimum(bx, ax, evaluate, context, expression0, expression1);
   }
   double e = 0.0;
   double a = ax;
@@ -425,7 +482,7 @@ typename Expression::Coordinate2D Expression::brentMinimum(char symbol, double a
   double x = a+k_goldenRatio*(b-a);
   double v = x;
   double w = x;
-  double fx = evaluate(symbol, x, context, angleUnit, *this, expression);
+  double fx = evaluate(x, context, expression0, expression1);
   double fw = fx;
   double fv = fw;
 
@@ -437,10 +494,10 @@ typename Expression::Coordinate2D Expression::brentMinimum(char symbol, double a
     double tol1 = k_sqrtEps*std::fabs(x)+1E-10;
     double tol2 = 2.0*tol1;
     if (std::fabs(x-m) <= tol2-0.5*(b-a))  {
-      double middleFax = evaluate(symbol, (x+a)/2.0, context, angleUnit, *this, expression);
-      double middleFbx = evaluate(symbol, (x+b)/2.0, context, angleUnit, *this, expression);
-      double fa = evaluate(symbol, a, context, angleUnit, *this, expression);
-      double fb = evaluate(symbol, b, context, angleUnit, *this, expression);
+      double middleFax = evaluate((x+a)/2.0, context, expression0, expression1);
+      double middleFbx = evaluate((x+b)/2.0, context, expression0, expression1);
+      double fa = evaluate(a, context, expression0, expression1);
+      double fb = evaluate(b, context, expression0, expression1);
       if (middleFax-fa <= k_sqrtEps && fx-middleFax <= k_sqrtEps && fx-middleFbx <= k_sqrtEps && middleFbx-fb <= k_sqrtEps) {
         Coordinate2D result = {.abscissa = x, .value = fx};
         return result;
@@ -473,7 +530,7 @@ typename Expression::Coordinate2D Expression::brentMinimum(char symbol, double a
       d = k_goldenRatio*e;
     }
     u = x + (std::fabs(d) >= tol1 ? d : (d>0 ? tol1 : -tol1));
-    fu = evaluate(symbol, u, context, angleUnit, *this, expression);
+    fu = evaluate(u, context, expression0, expression1);
     if (fu <= fx) {
       if (u<x) {
         b = x;
@@ -507,7 +564,7 @@ typename Expression::Coordinate2D Expression::brentMinimum(char symbol, double a
   return result;
 }
 
-double Expression::nextIntersectionWithExpression(char symbol, double start, double step, double max, EvaluationAtAbscissa evaluation, Context & context, Preferences::AngleUnit angleUnit, const Expression expression) const {
+double Expression::nextIntersectionWithExpression(double start, double step, double max, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1) {
   if (start == max || step == 0.0) {
     return NAN;
   }
@@ -516,27 +573,15 @@ double Expression::nextIntersectionWithExpression(char symbol, double start, dou
   static double precisionByGradUnit = 1E6;
   double x = start+step;
   do {
-    bracketRoot(symbol, x, step, max, bracket, evaluation, context, angleUnit, expression);
-    result = brentRoot(symbol, bracket[0], bracket[1], std::fabs(step/precisionByGradUnit), evaluation, context, angleUnit, expression);
+    bracketRoot(x, step, max, bracket, context, expression0, expression1);
+    result = brentRoot(bracket[0], bracket[1], std::fabs(step/precisionByGradUnit), context, expression0, expression1);
     x = bracket[1];
   } while (std::isnan(result) && (step > 0.0 ? x <= max : x >= max));
 
   double extremumMax = std::isnan(result) ? max : result;
   Coordinate2D resultExtremum[2] = {
-    nextMinimumOfExpression(symbol, start, step, extremumMax, [](char symbol, double x, Context & context, Preferences::AngleUnit angleUnit, const Expression expression0, const Expression expression1) {
-        if (expression1.isUninitialized()) {
-          return expression0.approximateWithValueForSymbol(symbol, x, context, angleUnit);
-        } else {
-          return expression0.approximateWithValueForSymbol(symbol, x, context, angleUnit)-expression1.approximateWithValueForSymbol(symbol, x, context, angleUnit);
-        }
-      }, context, angleUnit, expression, true),
-    nextMinimumOfExpression(symbol, start, step, extremumMax, [](char symbol, double x, Context & context, Preferences::AngleUnit angleUnit, const Expression expression0, const Expression expression1) {
-        if (expression1.isUninitialized()) {
-          return -expression0.approximateWithValueForSymbol(symbol, x, context, angleUnit);
-        } else {
-          return expression1.approximateWithValueForSymbol(symbol, x, context, angleUnit)-expression0.approximateWithValueForSymbol(symbol, x, context, angleUnit);
-        }
-      }, context, angleUnit, expression, true)};
+    nextMinimumOfExpression(start, step, extremumMax, evaluateDifference, context, expression0, expression1, true),
+    nextMinimumOfExpression(start, step, extremumMax, evaluateOppositeOfDifference, context, expression0, expression1, true)};
   for (int i = 0; i < 2; i++) {
     if (!std::isnan(resultExtremum[i].abscissa) && (std::isnan(result) || std::fabs(result - start) > std::fabs(resultExtremum[i].abscissa - start))) {
       result = resultExtremum[i].abscissa;
@@ -548,35 +593,146 @@ double Expression::nextIntersectionWithExpression(char symbol, double start, dou
   return result;
 }
 
-void Expression::bracketRoot(char symbol, double start, double step, double max, double result[2], EvaluationAtAbscissa evaluation, Context & context, Preferences::AngleUnit angleUnit, const Expression expression) const {
+int Expression::nextIntersectionsWithExpression(double start, double step, double max, double * results, int maxNumberOfResults, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1) {
+  /* Unlike repeated calls to nextIntersectionWithExpression, which sample the
+   * interval once to find sign changes and twice more to find extrema
+   * touching zero, and start over after each intersection, the interval is
+   * sampled once and each sample is used for both searches:
+   * - a sign change between two consecutive samples brackets a root which is
+   *   refined with brentRoot,
+   * - a sample whose value is closer to zero than its neighbours', with the
+   *   same sign, brackets an extremum which is refined with brentMinimum and
+   *   kept if it touches zero. */
+  if (start == max || step == 0.0 || maxNumberOfResults <= 0) {
+    return 0;
+  }
+  constexpr double precisionByGradUnit = 1E6;
+  double abscissae[k_bracketRootBatchSize];
+  double values[k_bracketRootBatchSize];
+  int numberOfResults = 0;
+  /* p[1] is the last sample and p[0] the last sample before it with a
+   * different value, so that extrema on plateaus are bracketed too, as in
+   * bracketMinimum. */
+  Coordinate2D p[2] = {{.abscissa = NAN, .value = NAN}, {.abscissa = NAN, .value = NAN}};
+  double x = start;
+  while (step > 0.0 ? x <= max : x >= max) {
+    int numberOfAbscissae = 0;
+    while (numberOfAbscissae < k_bracketRootBatchSize && (step > 0.0 ? x <= max : x >= max)) {
+      abscissae[numberOfAbscissae++] = x;
+      x += step;
+    }
+    approximateDifferenceWithValues(abscissae, values, numberOfAbscissae, context, expression0, expression1);
+    for (int i = 0; i < numberOfAbscissae; i++) {
+      double b = abscissae[i];
+      double fb = values[i];
+      if (!std::isnan(p[1].abscissa) && fb != p[1].value) {
+        // Extremum of the function or of its opposite touching zero
+        bool hasLeftNeighbour = !std::isnan(p[0].abscissa);
+        bool isMinimum = (p[0].value > p[1].value || std::isnan(p[0].value)) && (fb > p[1].value || std::isnan(fb));
+        bool isMaximum = (p[0].value < p[1].value || std::isnan(p[0].value)) && (fb < p[1].value || std::isnan(fb));
+        if (hasLeftNeighbour && (isMinimum || isMaximum) && (!std::isnan(p[0].value) || !std::isnan(fb))) {
+          Coordinate2D extremum = brentMinimum(p[0].abscissa, b, isMinimum ? evaluateDifference : evaluateOppositeOfDifference, context, expression0, expression1);
+          // Because of float approximation, exact zero is never reached
+          if (std::fabs(extremum.abscissa) < std::fabs(step)*k_solverPrecision) {
+            extremum.abscissa = 0;
+            extremum.value = evaluateDifference(0, context, expression0, expression1);
+          }
+          if (!std::isnan(extremum.value) && std::fabs(extremum.value) < std::fabs(step)*k_solverPrecision) {
+            addIntersection(extremum.abscissa, start, step, results, &numberOfResults, maxNumberOfResults);
+          }
+        }
+        p[0] = p[1];
+      }
+      if (p[1].value*fb <= 0) {
+        // Sign change
+        double root = brentRoot(p[1].abscissa, b, std::fabs(step/precisionByGradUnit), context, expression0, expression1);
+        if (!std::isnan(root)) {
+          addIntersection(std::fabs(root) < std::fabs(step)*k_solverPrecision ? 0 : root, start, step, results, &numberOfResults, maxNumberOfResults);
+        }
+      }
+      p[1] = {.abscissa = b, .value = fb};
+      /* Once results are full, only intersections before the last one could
+       * replace it, and the brackets of the next samples start after p[0]. */
+      if (numberOfResults == maxNumberOfResults && (p[0].abscissa - results[numberOfResults-1])*step > step*step) {
+        return numberOfResults;
+      }
+    }
+  }
+  return numberOfResults;
+}
+
+void Expression::addIntersection(double x, double start, double step, double * results, int * numberOfResults, int maxNumberOfResults) {
+  /* Results are sorted along the direction of step. As when looking for the
+   * next root from the previous one, intersections closer than a step are
+   * merged. */
+  int index = *numberOfResults;
+  while (index > 0 && (results[index-1] - x)*step > 0) {
+    index--;
+  }
+  if ((index > 0 && std::fabs(results[index-1] - x) < std::fabs(step)) || (index < *numberOfResults && std::fabs(results[index] - x) < std::fabs(step))) {
+    return;
+  }
+  if (index == maxNumberOfResults) {
+    return;
+  }
+  int newNumberOfResults = *numberOfResults < maxNumberOfResults ? *numberOfResults + 1 : maxNumberOfResults;
+  for (int i = newNumberOfResults - 1; i > index; i--) {
+    results[i] = results[i-1];
+  }
+  results[index] = x;
+  *numberOfResults = newNumberOfResults;
+}
+
+void Expression::approximateDifferenceWithValues(const double * abscissae, double * values, int numberOfAbscissae, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1) {
+  expression0.approximateWithValuesForSymbol(abscissae, values, numberOfAbscissae, context);
+  if (!expression1.isUninitialized()) {
+    double values1[k_bracketRootBatchSize];
+    assert(numberOfAbscissae <= k_bracketRootBatchSize);
+    expression1.approximateWithValuesForSymbol(abscissae, values1, numberOfAbscissae, context);
+    for (int i = 0; i < numberOfAbscissae; i++) {
+      values[i] -= values1[i];
+    }
+  }
+}
+
+void Expression::bracketRoot(double start, double step, double max, double result[2], Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1) {
+  double abscissae[k_bracketRootBatchSize];
+  double values[k_bracketRootBatchSize];
   double a = start;
+  double fa = evaluateDifference(a, context, expression0, expression1);
   double b = start+step;
   while (step > 0.0 ? b <= max : b >= max) {
-    double fa = evaluation(symbol, a, context, angleUnit, *this, expression);
-    double fb = evaluation(symbol, b, context, angleUnit,* this, expression);
-    if (fa*fb <= 0) {
-      result[0] = a;
-      result[1] = b;
-      return;
+    int numberOfAbscissae = 0;
+    while (numberOfAbscissae < k_bracketRootBatchSize && (step > 0.0 ? b <= max : b >= max)) {
+      abscissae[numberOfAbscissae++] = b;
+      b = b+step;
+    }
+    approximateDifferenceWithValues(abscissae, values, numberOfAbscissae, context, expression0, expression1);
+    for (int i = 0; i < numberOfAbscissae; i++) {
+      if (fa*values[i] <= 0) {
+        result[0] = a;
+        result[1] = abscissae[i];
+        return;
+      }
+      a = abscissae[i];
+      fa = values[i];
     }
-    a = b;
-    b = b+step;
   }
   result[0] = NAN;
   result[1] = NAN;
 }
 
-double Expression::brentRoot(char symbol, double ax, double bx, double precision, EvaluationAtAbscissa evaluation, Context & context, Preferences::AngleUnit angleUnit, const Expression expression) const {
+double Expression::brentRoot(double ax, double bx, double precision, Context & context, const CompiledExpression<double> & expression0, const CompiledExpression<double> & expression1) {
   if (ax > bx) {
-    return brentRoot(symbol, bx, ax, precision, evaluation, context, angleUnit, expression);
+    return brentRoot(bx, ax, precision, context, expression0, expression1);
   }
   double a = ax;
   double b = bx;
   double c = bx;
   double d = b-a;
   double e = b-a;
-  double fa = evaluation(symbol, a, context, angleUnit, *this, expression);
-  double fb = evaluation(symbol, b, context, angleUnit, *this, expression);
+  double fa = evaluateDifference(a, context, expression0, expression1);
+  double fb = evaluateDifference(b, context, expression0, expression1);
   double fc = fb;
   for (int i = 0; i < 100; i++) {
     if ((fb > 0.0 && fc > 0.0) || (fb < 0.0 && fc < 0.0)) {
@@ -596,7 +752,7 @@ double Expression::brentRoot(char symbol, double ax, double bx, double precision
     double tol1 = 2.0*DBL_EPSILON*std::fabs(b)+0.5*precision;
     double xm = 0.5*(c-b);
     if (std::fabs(xm) <= tol1 || fb == 0.0) {
-      double fbcMiddle = evaluation(symbol, 0.5*(b+c), context, angleUnit, *this, expression);
+      double fbcMiddle = evaluateDifference(0.5*(b+c), context, expression0, expression1);
       double isContinuous = (fb <= fbcMiddle && fbcMiddle <= fc) || (fc <= fbcMiddle && fbcMiddle <= fb);
       if (isContinuous) {
         return b;
@@ -634,7 +790,7 @@ double Expression::brentRoot(char symbol, double ax, double bx, double precision
     } else {
       b += xm > 0.0 ? tol1 : tol1;
     }
-    fb = evaluation(symbol, b, context, angleUnit, *this, expression);
+    fb = evaluateDifference(b, context, expression0, expression1);
   }
   return NAN;
 }
@@ -657,4 +813,7 @@ template Evaluation<double> Expression::approximateToEvaluation(Context& context
 template float Expression::approximateWithValueForSymbol(char symbol, float x, Context & context, Preferences::AngleUnit angleUnit) const;
 template double Expression::approximateWithValueForSymbol(char symbol, double x, Context & context, Preferences::AngleUnit angleUnit) const;
 
+template void Expression::approximateWithValuesForSymbol(char symbol, const float * x, float * results, int numberOfValues, Context & context, Preferences::AngleUnit angleUnit) const;
+template void Expression::approximateWithValuesForSymbol(char symbol, const double * x, double * results, int numberOfValues, Context & context, Preferences::AngleUnit angleUnit) const;
+
 }
@@ -4,6 +4,9 @@
 
 namespace Poincare {
 
+// The cached hash of TreeNode must not grow the expression nodes
+static_assert(sizeof(ExpressionNode) == sizeof(TreeNode) + sizeof(SerializationHelperInterface), "ExpressionNode should only add a vtable pointer to TreeNode");
+
 Expression ExpressionNode::replaceSymbolWithExpression(char symbol, Expression & expression) {
   return Expression(this).defaultReplaceSymbolWithExpression(symbol, expression);
 }
@@ -90,6 +93,22 @@ int ExpressionNode::simplificationOrderSameType(const ExpressionNode * e, bool c
   return 0;
 }
 
+uint8_t ExpressionNode::structuralHash() const {
+  if (!hasCachedHash()) {
+    setCachedHash(computeStructuralHash());
+  }
+  return cachedHash();
+}
+
+uint8_t ExpressionNode::computeStructuralHash() const {
+  uint32_t hash = CombineHash(2166136261, static_cast<uint32_t>(type()));
+  hash = CombineHash(hash, numberOfChildren());
+  for (ExpressionNode * c : children()) {
+    hash = CombineHash(hash, c->structuralHash());
+  }
+  return FoldHash(hash);
+}
+
 Expression ExpressionNode::shallowReduce(Context & context, Preferences::AngleUnit angleUnit) {
   return Expression(this).defaultShallowReduce(context, angleUnit);
 }
@@ -5,6 +5,11 @@
  * backpointer to the resulting expression. */
 %parse-param { Poincare::Expression * expressionOutput }
 
+/* The lexer is reentrant: its state is an opaque yyscan_t, which yyparse
+ * receives as a second parameter and hands over to each call to yylex. */
+%parse-param { void * scanner }
+%lex-param { void * scanner }
+
 /* The value stored in each token is an Expresssion, which is a complex C++
  * object. If we use a global variable to keep track of yylval, this object will
  * be long-lived AND will need to be initialized at startup.
@@ -31,7 +36,7 @@
 
 /* Declare our error-handling function. Since we're making a re-entrant parser,
  * it takes a context parameter as its first input. */
-void poincare_expression_yyerror(Poincare::Expression * expressionOutput, char const *msg);
+void poincare_expression_yyerror(Poincare::Expression * expressionOutput, void * scanner, char const *msg);
 
 /* Bison expects to use __builtin_memcpy. We don't want to provide this, but
  * instead we do provide regular memcpy. Let's instruct Bison to use it. */
@@ -158,7 +163,7 @@ final_exp : exp           { $$ = $1; }
           ;
 %%
 
-void poincare_expression_yyerror(Expression * expressionOutput, const char * msg) {
+void poincare_expression_yyerror(Expression * expressionOutput, void * scanner, const char * msg) {
   // Handle the error!
   // TODO: handle explicitely different type of errors (division by 0, missing parenthesis). This should call back the container to display a pop up with a message corresponding to the error?
 }
@@ -4,6 +4,14 @@ namespace Poincare {
 
 template<typename T>
 Complex<T> HyperbolicTangentNode::computeOnComplex(const std::complex<T> c, Preferences::AngleUnit angleUnit) {
+  /* tanh has poles at i*(k+1/2)*Pi, where cosh is 0. The approximation of
+   * such an argument is only known up to about |c|*epsilon, and the libm
+   * returns a large finite value there: if cosh is not larger than that
+   * error, the pole cannot be ruled out and tanh is undefined, as tan is
+   * undefined when cos rounds to 0. */
+  if (std::abs(std::cosh(c)) <= std::abs(c)*Expression::epsilon<T>()) {
+    return Complex<T>::Undefined();
+  }
   return Complex<T>(Trigonometry::RoundToMeaningfulDigits(std::tanh(c)));
 }
 
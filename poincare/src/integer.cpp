@@ -1,5 +1,6 @@
 #include <poincare/integer.h>
 #include <poincare/ieee754.h>
+#include <poincare/integer_digit_arena.h>
 #include <poincare/layout_helper.h>
 #include <cmath>
 #include <utility>
@@ -48,32 +49,149 @@ void Integer::log(std::ostream & stream) const {
 
 #endif
 
+/* Digit arrays
+ * The following helpers work on little-endian arrays of native digits, which
+ * may have leading zeros. They let the arithmetic run on stack buffers
+ * instead of allocating an Integer for each intermediate result. */
+
+static inline int numberOfSignificantDigits(const native_uint_t * digits, int numberOfDigits) {
+  while (numberOfDigits > 0 && digits[numberOfDigits-1] == 0) {
+    numberOfDigits--;
+  }
+  return numberOfDigits;
+}
+
+/* result[0..na+nb) = a*b
+ * An Integer has at most k_maxNumberOfDigits digits, so balanced operands
+ * have no more than 17 digits: at that size, the schoolbook product is faster
+ * than Karatsuba's, whose bookkeeping outweighs the saved digit products. */
+static void schoolbookMultiplication(const native_uint_t * a, int na, const native_uint_t * b, int nb, native_uint_t * result) {
+  memset(result, 0, (na+nb)*sizeof(native_uint_t));
+  for (int i = 0; i < na; i++) {
+    /* The fact that aDigit is double_native is very important, otherwise the
+     * product might end up being computed on single_native size. The sum
+     * cannot overflow: (2^32-1)^2 + 2*(2^32-1) = 2^64-1. */
+    double_native_uint_t aDigit = a[i];
+    double_native_uint_t carry = 0;
+    for (int j = 0; j < nb; j++) {
+      double_native_uint_t p = aDigit*b[j] + result[i+j] + carry;
+      result[i+j] = (native_uint_t)p;
+      carry = p >> 32;
+    }
+    result[i+nb] = (native_uint_t)carry;
+  }
+}
+
+constexpr static int k_maxNumberOfOperandDigits = Integer::k_maxNumberOfDigits+2;
+
+/* Knuth's algorithm D (The Art of Computer Programming, vol. 2, 4.3.1) on
+ * native digits: q[0..m-n] = u/v and r[0..n) = u%v, where u has m digits and
+ * v has n significant digits, with m >= n. */
+static void knuthDivision(const native_uint_t * u, int m, const native_uint_t * v, int n, native_uint_t * q, native_uint_t * r) {
+  assert(m >= n && n > 0 && v[n-1] != 0);
+  constexpr double_native_uint_t base = (double_native_uint_t)1 << 32;
+  if (n == 1) {
+    double_native_uint_t remainder = 0;
+    for (int j = m-1; j >= 0; j--) {
+      double_native_uint_t t = (remainder << 32) | u[j];
+      q[j] = t/v[0];
+      remainder = t - (double_native_uint_t)q[j]*v[0];
+    }
+    r[0] = remainder;
+    return;
+  }
+  /* Normalize u and v so that the most significant bit of v is set: the
+   * estimated quotient digits are then off by at most 2. */
+  int shift = 0;
+  while (!(v[n-1] & ((native_uint_t)1 << (31-shift)))) {
+    shift++;
+  }
+  native_uint_t vn[k_maxNumberOfOperandDigits];
+  native_uint_t un[k_maxNumberOfOperandDigits+1];
+  assert(m < k_maxNumberOfOperandDigits);
+  for (int i = n-1; i > 0; i--) {
+    vn[i] = (v[i] << shift) | (native_uint_t)((double_native_uint_t)v[i-1] >> (32-shift));
+  }
+  vn[0] = v[0] << shift;
+  un[m] = (double_native_uint_t)u[m-1] >> (32-shift);
+  for (int i = m-1; i > 0; i--) {
+    un[i] = (u[i] << shift) | (native_uint_t)((double_native_uint_t)u[i-1] >> (32-shift));
+  }
+  un[0] = u[0] << shift;
+
+  for (int j = m-n; j >= 0; j--) {
+    // Estimate the quotient digit from the two leading digits
+    double_native_uint_t numerator = ((double_native_uint_t)un[j+n] << 32) | un[j+n-1];
+    double_native_uint_t qhat = numerator/vn[n-1];
+    double_native_uint_t rhat = numerator - qhat*vn[n-1];
+    while (qhat >= base || qhat*vn[n-2] > ((rhat << 32) | un[j+n-2])) {
+      qhat--;
+      rhat += vn[n-1];
+      if (rhat >= base) {
+        break;
+      }
+    }
+    // Multiply and subtract: un[j..j+n] -= qhat*vn
+    double_native_int_t borrow = 0;
+    double_native_int_t t;
+    for (int i = 0; i < n; i++) {
+      double_native_uint_t p = qhat*vn[i];
+      t = (double_native_int_t)un[i+j] - borrow - (double_native_int_t)(p & 0xFFFFFFFF);
+      un[i+j] = (native_uint_t)t;
+      borrow = (double_native_int_t)(p >> 32) - (t >> 32);
+    }
+    t = (double_native_int_t)un[j+n] - borrow;
+    un[j+n] = (native_uint_t)t;
+    q[j] = (native_uint_t)qhat;
+    if (t < 0) {
+      // qhat was one too large: add v back
+      q[j]--;
+      double_native_uint_t carry = 0;
+      for (int i = 0; i < n; i++) {
+        carry += (double_native_uint_t)un[i+j] + vn[i];
+        un[i+j] = (native_uint_t)carry;
+        carry >>= 32;
+      }
+      un[j+n] += (native_uint_t)carry;
+    }
+  }
+  // Unnormalize the remainder
+  for (int i = 0; i < n-1; i++) {
+    r[i] = (un[i] >> shift) | (native_uint_t)((double_native_uint_t)un[i+1] << (32-shift));
+  }
+  r[n-1] = un[n-1] >> shift;
+}
+
+/* Divide digits[0..*numberOfDigits) in place by 10^9, the largest power of 10
+ * which fits in a native digit, and return the remainder. Converting to and
+ * from base 10 nine decimal digits at a time takes a single pass over the
+ * digits for each chunk. */
+constexpr static native_uint_t k_base10Chunk = 1000000000;
+constexpr static int k_numberOfDecimalDigitsInChunk = 9;
+
+static native_uint_t divideByBase10Chunk(native_uint_t * digits, int * numberOfDigits) {
+  double_native_uint_t remainder = 0;
+  for (int i = *numberOfDigits-1; i >= 0; i--) {
+    double_native_uint_t t = (remainder << 32) | digits[i];
+    digits[i] = t/k_base10Chunk;
+    remainder = t - (double_native_uint_t)digits[i]*k_base10Chunk;
+  }
+  *numberOfDigits = numberOfSignificantDigits(digits, *numberOfDigits);
+  return remainder;
+}
+
 /* new operator */
 
-// This bit buffer indicates which cases of the sIntegerBuffer are already allocated
-static uint16_t sbusyIntegerBuffer = 0;
-static native_uint_t sIntegerBuffer[(Integer::k_maxNumberOfDigits+1)*Integer::k_maxNumberOfIntegerSimutaneously];
+static_assert(IntegerDigitArena::k_maxNumberOfDigitsInBlock == Integer::k_maxNumberOfDigits+1, "The IntegerDigitArena blocks cannot hold the largest Integers");
+static_assert(IntegerDigitArena::k_numberOfLargestBlocks >= Integer::k_maxNumberOfIntegerSimutaneously, "The IntegerDigitArena cannot hold enough large Integers");
 
 native_uint_t * Integer::allocDigits(int numberOfDigits) {
   assert(numberOfDigits <= k_maxNumberOfDigits+1);
-  uint16_t bitIndex = 1 << (16-1);
-  int index = 0;
-  while (sbusyIntegerBuffer & bitIndex) {
-    bitIndex >>= 1;
-    index++;
-  }
-  if (bitIndex == 0) { // we overflow the sIntegerBuffer
-    assert(false);
-    return nullptr;
-  }
-  sbusyIntegerBuffer |= bitIndex;
-  return sIntegerBuffer+index*(Integer::k_maxNumberOfDigits+1);
+  return IntegerDigitArena::Alloc(numberOfDigits);
 }
 
 void Integer::freeDigits(native_uint_t * digits) {
-  int index = (digits - sIntegerBuffer)/(Integer::k_maxNumberOfDigits+1);
-  assert(index < 16);
-  sbusyIntegerBuffer &= ~((uint16_t)1 << (16-1-index));
+  IntegerDigitArena::Free(digits);
 }
 
 // Constructor
@@ -147,11 +265,16 @@ Integer::Integer(const char * digits, size_t length, bool negative) :
     length--;
   }
   if (digits != nullptr) {
-    Integer base(10);
-    for (size_t i = 0; i < length; i++) {
-      *this = Multiplication(*this, base);
-      *this = Addition(*this, Integer(*digits-'0'));
-      digits++;
+    // Accumulate the digits by chunks of 9
+    size_t i = 0;
+    while (i < length) {
+      native_uint_t chunk = 0;
+      native_uint_t chunkBase = 1;
+      for (int j = 0; j < k_numberOfDecimalDigitsInChunk && i < length; j++, i++) {
+        chunk = 10*chunk + (digits[i]-'0');
+        chunkBase *= 10;
+      }
+      *this = Addition(Multiplication(*this, Integer((native_int_t)chunkBase)), Integer((native_int_t)chunk));
     }
   }
 
@@ -249,10 +372,6 @@ int Integer::serialize(char * buffer, int bufferSize) const {
     return PrintFloat::convertFloatToText<float>(m_negative ? -INFINITY : INFINITY, buffer, bufferSize, PrintFloat::k_numberOfStoredSignificantDigits, Preferences::PrintFloatMode::Decimal);
   }
 
-  Integer base(10);
-  Integer abs = *this;
-  abs.setNegative(false);
-  IntegerDivision d = udiv(abs, base);
   int size = 0;
   if (bufferSize == 1) {
     return 0;
@@ -263,14 +382,19 @@ int Integer::serialize(char * buffer, int bufferSize) const {
     buffer[size++] = '-';
   }
 
-  while (!(d.remainder.isZero() &&
-        d.quotient.isZero())) {
-    char c = char_from_digit(d.remainder.isZero() ? 0 : d.remainder.digit(0));
-    if (size >= bufferSize-1) {
-      return PrintFloat::convertFloatToText<float>(NAN, buffer, bufferSize, PrintFloat::k_numberOfStoredSignificantDigits, Preferences::PrintFloatMode::Decimal);
+  // Write the decimal digits from the least significant one
+  native_uint_t digits[k_maxNumberOfDigits+1];
+  int numberOfDigits = m_numberOfDigits;
+  memcpy(digits, this->digits(), numberOfDigits*sizeof(native_uint_t));
+  while (numberOfDigits > 0) {
+    native_uint_t chunk = divideByBase10Chunk(digits, &numberOfDigits);
+    for (int i = 0; i < k_numberOfDecimalDigitsInChunk && (numberOfDigits > 0 || chunk != 0); i++) {
+      if (size >= bufferSize-1) {
+        return PrintFloat::convertFloatToText<float>(NAN, buffer, bufferSize, PrintFloat::k_numberOfStoredSignificantDigits, Preferences::PrintFloatMode::Decimal);
+      }
+      buffer[size++] = char_from_digit(chunk%10);
+      chunk /= 10;
     }
-    buffer[size++] = c;
-    d = udiv(d.quotient, base);
   }
   buffer[size] = 0;
 
@@ -367,14 +491,23 @@ T Integer::approximate() const {
 
 int Integer::NumberOfBase10DigitsWithoutSign(const Integer & i) {
   assert(!i.isInfinity());
-  int numberOfDigits = 1;
-  Integer base(10);
-  IntegerDivision d = udiv(i, base);
-  while (!d.quotient.isZero()) {
-    d = udiv(d.quotient, base);
-    numberOfDigits++;
+  native_uint_t digits[k_maxNumberOfDigits+1];
+  int numberOfDigits = i.m_numberOfDigits;
+  memcpy(digits, i.digits(), numberOfDigits*sizeof(native_uint_t));
+  int numberOfBase10Digits = 0;
+  native_uint_t chunk = 0;
+  while (numberOfDigits > 0) {
+    chunk = divideByBase10Chunk(digits, &numberOfDigits);
+    if (numberOfDigits > 0) {
+      numberOfBase10Digits += k_numberOfDecimalDigitsInChunk;
+    }
   }
-  return numberOfDigits;
+  // The last chunk has no leading zeros
+  do {
+    numberOfBase10Digits++;
+    chunk /= 10;
+  } while (chunk != 0);
+  return numberOfBase10Digits;
 }
 
 // Comparison
@@ -405,14 +538,28 @@ IntegerDivision Integer::Division(const Integer & numerator, const Integer & den
 }
 
 Integer Integer::Power(const Integer & i, const Integer & j) {
-  // TODO: optimize with dichotomia
   assert(!j.isNegative());
-  Integer index(j);
+  if (j.isOverflow()) {
+    return i.isZero() || i.isOne() ? i : Integer::Overflow(i.isNegative());
+  }
+  // Exponentiation by squaring, on the absolute value of i
   Integer result(1);
-  while (!index.isZero()) {
-    result = Multiplication(result, i);
-    index = usum(index, Integer(1), true);
+  Integer square(i);
+  square.setNegative(false);
+  for (uint8_t d = 0; d < j.m_numberOfDigits; d++) {
+    native_uint_t bits = j.digit(d);
+    bool isLastDigit = d == j.m_numberOfDigits-1;
+    for (int b = 0; b < 32 && (bits != 0 || !isLastDigit); b++) {
+      if (bits & 1) {
+        result = Multiplication(result, square);
+      }
+      bits >>= 1;
+      if (bits != 0 || !isLastDigit) {
+        square = Multiplication(square, square);
+      }
+    }
   }
+  result.setNegative(i.isNegative() && !j.isZero() && !j.isEven());
   return result;
 }
 
@@ -455,46 +602,18 @@ Integer Integer::multiplication(const Integer & a, const Integer & b, bool oneDi
   if (a.isOverflow() || b.isOverflow()) {
     return Integer::Overflow(a.m_negative != b.m_negative);
   }
-
-  uint8_t size = min(a.m_numberOfDigits + b.m_numberOfDigits, k_maxNumberOfDigits + oneDigitOverflow); // Enable overflowing of 1 digit
-
-  native_uint_t * digits = allocDigits(size);
-  memset(digits, 0, size*sizeof(native_uint_t));
-
-  double_native_uint_t carry = 0;
-  for (uint8_t i = 0; i < a.m_numberOfDigits; i++) {
-    double_native_uint_t aDigit = a.digit(i);
-    carry = 0;
-    for (uint8_t j = 0; j < b.m_numberOfDigits; j++) {
-      double_native_uint_t bDigit = b.digit(j);
-      /* The fact that aDigit and bDigit are double_native is very important,
-       * otherwise the product might end up being computed on single_native size
-       * and then zero-padded. */
-      double_native_uint_t p = aDigit*bDigit + carry + (double_native_uint_t)(digits[i+j]); // TODO: Prove it cannot overflow double_native type
-      native_uint_t * l = (native_uint_t *)&p;
-      if (i+j < (uint8_t) k_maxNumberOfDigits+oneDigitOverflow) {
-        digits[i+j] = l[0];
-      } else {
-        if (l[0] != 0) {
-          // Overflow the largest Integer
-          freeDigits(digits);
-          return Integer::Overflow(a.m_negative != b.m_negative);
-        }      }
-      carry = l[1];
-    }
-    if (i+b.m_numberOfDigits < (uint8_t) k_maxNumberOfDigits+oneDigitOverflow) {
-      digits[i+b.m_numberOfDigits] += carry;
-    } else {
-      if (carry != 0) {
-        // Overflow the largest Integer
-        freeDigits(digits);
-        return Integer::Overflow(a.m_negative != b.m_negative);
-      }
-    }
+  if (a.isZero() || b.isZero()) {
+    return Integer(0);
   }
-  while (size>0 && digits[size-1] == 0) {
-    size--;
+  native_uint_t product[2*(k_maxNumberOfDigits+1)];
+  schoolbookMultiplication(a.digits(), a.m_numberOfDigits, b.digits(), b.m_numberOfDigits, product);
+  int size = numberOfSignificantDigits(product, a.m_numberOfDigits + b.m_numberOfDigits);
+  if (size > k_maxNumberOfDigits + oneDigitOverflow) {
+    // Overflow the largest Integer
+    return Integer::Overflow(a.m_negative != b.m_negative);
   }
+  native_uint_t * digits = allocDigits(size);
+  memcpy(digits, product, size*sizeof(native_uint_t));
   return Integer(digits, size, a.m_negative != b.m_negative, oneDigitOverflow);
 }
 
@@ -527,7 +646,7 @@ Integer Integer::usum(const Integer & a, const Integer & b, bool subtract, bool
     // Addition can overflow
     size++;
   }
-  native_uint_t * digits = allocDigits(max(size, k_maxNumberOfDigits+oneDigitOverflow));
+  native_uint_t * digits = allocDigits(min(size, k_maxNumberOfDigits+oneDigitOverflow));
   bool carry = false;
   for (uint8_t i = 0; i < size; i++) {
     native_uint_t aDigit = (i >= a.m_numberOfDigits ? 0 : a.digit(i));
@@ -555,40 +674,6 @@ Integer Integer::usum(const Integer & a, const Integer & b, bool subtract, bool
   return Integer(digits, size, false, oneDigitOverflow);
 }
 
-Integer Integer::multiplyByPowerOf2(uint8_t pow) const {
-  assert(pow < 32);
-  native_uint_t * digits = allocDigits(m_numberOfDigits+1);
-  native_uint_t carry = 0;
-  for (uint8_t i = 0; i < m_numberOfDigits; i++) {
-    digits[i] = digit(i) << pow | carry;
-    carry = pow == 0 ? 0 : digit(i) >> (32-pow);
-  }
-  digits[m_numberOfDigits] = carry;
-  return Integer(digits, carry ? m_numberOfDigits + 1 : m_numberOfDigits, false, true);
-}
-
-Integer Integer::divideByPowerOf2(uint8_t pow) const {
-  assert(pow < 32);
-  native_uint_t * digits = allocDigits(m_numberOfDigits);
-  native_uint_t carry = 0;
-  for (int i = m_numberOfDigits - 1; i >= 0; i--) {
-    digits[i] = digit(i) >> pow | carry;
-    carry = pow == 0 ? 0 : digit(i) << (32-pow);
-  }
-  return Integer(digits, digits[m_numberOfDigits-1] > 0 ? m_numberOfDigits : m_numberOfDigits-1, false, true);
-}
-
-Integer Integer::multiplyByPowerOfBase(uint8_t pow) const {
-  int nbOfHalfDigits = numberOfHalfDigits();
-  half_native_uint_t * digits = (half_native_uint_t *)allocDigits(m_numberOfDigits+(pow+1)/2);
-  memset(digits, 0, sizeof(native_uint_t)*(m_numberOfDigits+(pow+1)/2));
-  for (uint8_t i = 0; i < nbOfHalfDigits; i++) {
-    digits[i+pow] = halfDigit(i);
-  }
-  nbOfHalfDigits += pow;
-  return Integer((native_uint_t *)digits, nbOfHalfDigits%2 == 1 ? nbOfHalfDigits/2+1 : nbOfHalfDigits/2, false, true);
-}
-
 IntegerDivision Integer::udiv(const Integer & numerator, const Integer & denominator) {
   if (denominator.isOverflow()) {
     return {.quotient = Integer(0), .remainder = Integer::Overflow(false)};
@@ -596,62 +681,20 @@ IntegerDivision Integer::udiv(const Integer & numerator, const Integer & denomin
   if(numerator.isOverflow()) {
     return {.quotient = Integer::Overflow(false), .remainder = Integer(0)};
   }
-  /* Modern Computer Arithmetic, Richard P. Brent and Paul Zimmermann
-   * (Algorithm 1.6) */
   assert(!denominator.isZero());
   if (ucmp(numerator,denominator) < 0) {
     IntegerDivision div = {.quotient = Integer(0), .remainder = Integer(numerator)};
     return div;
   }
-  /* Let's call beta = 1 << 16 */
-  /* Normalize numerator & denominator:
-   * Find A = 2^k*numerator & B = 2^k*denominator such as B > beta/2
-   * if A = B*Q+R (R < B) then numerator = denominator*Q + R/2^k. */
-  half_native_uint_t b = denominator.halfDigit(denominator.numberOfHalfDigits()-1);
-  half_native_uint_t halfBase = 1 << (16-1);
-  int pow = 0;
-  assert(b != 0);
-  while (!(b & halfBase)) {
-    b = b << 1;
-    pow++;
-  }
-  Integer A = numerator.multiplyByPowerOf2(pow);
-  Integer B = denominator.multiplyByPowerOf2(pow);
-
-  /* A = a[0] + a[1]*beta + ... + a[n+m-1]*beta^(n+m-1)
-   * B = b[0] + b[1]*beta + ... + b[n-1]*beta^(n-1) */
-  int n = B.numberOfHalfDigits();
-  int m = A.numberOfHalfDigits()-n;
-  // qDigits is a half_native_uint_t array and enable one digit overflow
-  half_native_uint_t * qDigits = (half_native_uint_t *)allocDigits(m/2+1);
-  memset(qDigits, 0, (m/2+1)*sizeof(native_uint_t));
-  // betaMB = B*beta^m
-  Integer betaMB = B.multiplyByPowerOfBase(m);
-  if (Integer::NaturalOrder(A,betaMB) >= 0) { // A >= B*beta^m
-    qDigits[m] = 1; // q[m] = 1
-    A = usum(A, betaMB, true, true); // A-B*beta^m
-  }
-  native_int_t base = 1 << 16;
-  for (int j = m-1; j >= 0; j--) {
-    native_uint_t qj2 = ((native_uint_t)A.halfDigit(n+j)*base+(native_uint_t)A.halfDigit(n+j-1))/(native_uint_t)B.halfDigit(n-1); // (a[n+j]*beta+a[n+j-1])/b[n-1]
-    half_native_uint_t baseMinus1 = (1 << 16) -1; // beta-1
-    qDigits[j] = qj2 < (native_uint_t)baseMinus1 ? (half_native_uint_t)qj2 : baseMinus1; // min(qj2, beta -1)
-    A = Integer::addition(A, multiplication(qDigits[j], B.multiplyByPowerOfBase(j), true), true, true); // A-q[j]*beta^j*B
-    Integer betaJM = B.multiplyByPowerOfBase(j); // betaJM = B*beta^j
-    while (A.isNegative()) {
-      qDigits[j] = qDigits[j]-1; // q[j] = q[j]-1
-      A = addition(A, betaJM, false, true); // A = B*beta^j+A
-    }
-  }
-  int qNumberOfDigits = m+1;
-  while (qDigits[qNumberOfDigits-1] == 0 && qNumberOfDigits > 1) {
-    qNumberOfDigits--;
-  }
-  int qNumberOfDigitsInBase32 = qNumberOfDigits%2 == 1 ? qNumberOfDigits/2+1 : qNumberOfDigits/2;
-  IntegerDivision div = {.quotient = Integer((native_uint_t *)qDigits, qNumberOfDigitsInBase32, false), .remainder = A};
-  if (pow > 0 && !div.remainder.isZero()) {
-    div.remainder = div.remainder.divideByPowerOf2(pow);
-  }
+  int m = numerator.m_numberOfDigits;
+  int n = denominator.m_numberOfDigits;
+  native_uint_t * qDigits = allocDigits(m-n+1);
+  native_uint_t * rDigits = allocDigits(n);
+  knuthDivision(numerator.digits(), m, denominator.digits(), n, qDigits, rDigits);
+  IntegerDivision div = {
+    .quotient = Integer(qDigits, numberOfSignificantDigits(qDigits, m-n+1), false),
+    .remainder = Integer(rDigits, numberOfSignificantDigits(rDigits, n), false, true)
+  };
   return div;
 }
 
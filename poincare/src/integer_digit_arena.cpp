@@ -0,0 +1,125 @@
+#include <poincare/integer_digit_arena.h>
+#include <poincare/exception_checkpoint.h>
+#include <poincare/thread_local.h>
+#include <assert.h>
+
+namespace Poincare {
+
+struct SizeClass {
+  uint8_t numberOfDigitsInBlock;
+  uint8_t numberOfBlocks;
+  uint16_t firstDigit;
+};
+
+/* Small integers are the most frequent ones: rationals of a few digits are
+ * built at each step of a simplification. */
+static constexpr SizeClass sSizeClasses[IntegerDigitArena::k_numberOfSizeClasses] = {
+  {2, 32, 0},
+  {4, 32, 64},
+  {8, 16, 192},
+  {16, 8, 320},
+  {IntegerDigitArena::k_maxNumberOfDigitsInBlock, IntegerDigitArena::k_numberOfLargestBlocks, 448}
+};
+static constexpr int k_numberOfDigitsInArena = 448 + IntegerDigitArena::k_maxNumberOfDigitsInBlock*IntegerDigitArena::k_numberOfLargestBlocks;
+
+constexpr static IntegerDigitArena::Bitmap k_firstBlockBit = (IntegerDigitArena::Bitmap)1 << 31;
+
+// Bitmap of all the blocks of a size class, the first block being the highest bit
+constexpr static IntegerDigitArena::Bitmap AllBlocks(int numberOfBlocks) {
+  return numberOfBlocks == 32 ? 0xFFFFFFFF : ~((IntegerDigitArena::Bitmap)0xFFFFFFFF >> numberOfBlocks);
+}
+
+static POINCARE_THREAD_LOCAL uint32_t sDigits[k_numberOfDigitsInArena];
+static POINCARE_THREAD_LOCAL IntegerDigitArena::Bitmap sFreeBlocks[IntegerDigitArena::k_numberOfSizeClasses] = {
+  AllBlocks(32),
+  AllBlocks(32),
+  AllBlocks(16),
+  AllBlocks(8),
+  AllBlocks(IntegerDigitArena::k_numberOfLargestBlocks)
+};
+#if DEBUG
+// Blocks freed by a rollback which have not been allocated again since
+static POINCARE_THREAD_LOCAL IntegerDigitArena::Bitmap sRolledBackBlocks[IntegerDigitArena::k_numberOfSizeClasses];
+#endif
+static POINCARE_THREAD_LOCAL int sNumberOfUsedBlocks = 0;
+static POINCARE_THREAD_LOCAL int sPeakNumberOfUsedBlocks = 0;
+
+uint32_t * IntegerDigitArena::Alloc(int numberOfDigits) {
+  assert(numberOfDigits >= 0 && numberOfDigits <= k_maxNumberOfDigitsInBlock);
+  for (int c = 0; c < k_numberOfSizeClasses; c++) {
+    const SizeClass & sizeClass = sSizeClasses[c];
+    if (numberOfDigits > sizeClass.numberOfDigitsInBlock || sFreeBlocks[c] == 0) {
+      continue;
+    }
+    int block = __builtin_clz(sFreeBlocks[c]);
+    sFreeBlocks[c] &= ~(k_firstBlockBit >> block);
+#if DEBUG
+    sRolledBackBlocks[c] &= ~(k_firstBlockBit >> block);
+#endif
+    sNumberOfUsedBlocks++;
+    if (sNumberOfUsedBlocks > sPeakNumberOfUsedBlocks) {
+      sPeakNumberOfUsedBlocks = sNumberOfUsedBlocks;
+    }
+    return sDigits + sizeClass.firstDigit + block*sizeClass.numberOfDigitsInBlock;
+  }
+  // Every block that could hold the digits is in use
+  ExceptionCheckpoint::Raise();
+  return nullptr;
+}
+
+void IntegerDigitArena::Free(uint32_t * digits) {
+  assert(digits >= sDigits && digits < sDigits + k_numberOfDigitsInArena);
+  int offset = digits - sDigits;
+  int c = k_numberOfSizeClasses - 1;
+  while (offset < sSizeClasses[c].firstDigit) {
+    c--;
+  }
+  int block = (offset - sSizeClasses[c].firstDigit)/sSizeClasses[c].numberOfDigitsInBlock;
+  assert(sSizeClasses[c].firstDigit + block*sSizeClasses[c].numberOfDigitsInBlock == offset);
+#if DEBUG
+  /* The digits were allocated in the region of an ExceptionCheckpoint which
+   * has been rolled back, by an Integer which outlived it. */
+  assert((sRolledBackBlocks[c] & (k_firstBlockBit >> block)) == 0);
+#endif
+  assert((sFreeBlocks[c] & (k_firstBlockBit >> block)) == 0);
+  sFreeBlocks[c] |= k_firstBlockBit >> block;
+  sNumberOfUsedBlocks--;
+}
+
+IntegerDigitArena::Snapshot IntegerDigitArena::TakeSnapshot() {
+  Snapshot snapshot;
+  for (int c = 0; c < k_numberOfSizeClasses; c++) {
+    snapshot.usedBlocks[c] = AllBlocks(sSizeClasses[c].numberOfBlocks) & ~sFreeBlocks[c];
+  }
+  return snapshot;
+}
+
+void IntegerDigitArena::Rollback(const Snapshot & snapshot) {
+  /* A block used now but not in the snapshot belongs to an integer of an
+   * unwound frame. A block used in the snapshot but freed since is free. Both
+   * kinds are freed, the blocks of the integers that outlive the rollback are
+   * used in both. */
+  sNumberOfUsedBlocks = 0;
+  for (int c = 0; c < k_numberOfSizeClasses; c++) {
+    Bitmap usedBlocks = snapshot.usedBlocks[c] & ~sFreeBlocks[c];
+#if DEBUG
+    sRolledBackBlocks[c] |= ~sFreeBlocks[c] & ~usedBlocks;
+#endif
+    sFreeBlocks[c] = AllBlocks(sSizeClasses[c].numberOfBlocks) & ~usedBlocks;
+    sNumberOfUsedBlocks += __builtin_popcount(usedBlocks);
+  }
+}
+
+int IntegerDigitArena::NumberOfUsedBlocks() {
+  return sNumberOfUsedBlocks;
+}
+
+int IntegerDigitArena::PeakNumberOfUsedBlocks() {
+  return sPeakNumberOfUsedBlocks;
+}
+
+void IntegerDigitArena::ResetPeakNumberOfUsedBlocks() {
+  sPeakNumberOfUsedBlocks = sNumberOfUsedBlocks;
+}
+
+}
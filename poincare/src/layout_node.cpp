@@ -1,4 +1,5 @@
 #include <poincare/layout.h>
+#include <poincare/char_layout.h>
 #include <poincare/horizontal_layout.h>
 #include <poincare/layout_cursor.h>
 #include <poincare/layout.h>
@@ -9,10 +10,41 @@ namespace Poincare {
 
 // Rendering
 
+static void drawCharRun(KDContext * ctx, char * run, int * runLength, KDPoint origin, KDText::FontSize fontSize, KDColor expressionColor, KDColor backgroundColor) {
+  if (*runLength == 0) {
+    return;
+  }
+  run[*runLength] = 0;
+  ctx->drawString(run, origin, fontSize, expressionColor, backgroundColor);
+  *runLength = 0;
+}
+
 void LayoutNode::draw(KDContext * ctx, KDPoint p, KDColor expressionColor, KDColor backgroundColor) {
+  /* Consecutive CharLayouts of a horizontal layout are side by side on the
+   * same baseline: they are drawn as one string, which the context renders as
+   * a single glyph run instead of one pushRect per char. */
+  constexpr int k_maxNumberOfCharsInRun = 32;
+  char run[k_maxNumberOfCharsInRun+1];
+  int runLength = 0;
+  KDPoint runOrigin = KDPointZero;
+  KDText::FontSize runFontSize = KDText::FontSize::Large;
   for (LayoutNode * l : children()) {
+    if (isHorizontal() && l->isChar()) {
+      CharLayoutNode * c = static_cast<CharLayoutNode *>(l);
+      if (runLength > 0 && (c->fontSize() != runFontSize || runLength == k_maxNumberOfCharsInRun)) {
+        drawCharRun(ctx, run, &runLength, runOrigin, runFontSize, expressionColor, backgroundColor);
+      }
+      if (runLength == 0) {
+        runOrigin = l->absoluteOrigin().translatedBy(p);
+        runFontSize = c->fontSize();
+      }
+      run[runLength++] = c->character();
+      continue;
+    }
+    drawCharRun(ctx, run, &runLength, runOrigin, runFontSize, expressionColor, backgroundColor);
     l->draw(ctx, p, expressionColor, backgroundColor);
   }
+  drawCharRun(ctx, run, &runLength, runOrigin, runFontSize, expressionColor, backgroundColor);
   render(ctx, absoluteOrigin().translatedBy(p), expressionColor, backgroundColor);
 }
 
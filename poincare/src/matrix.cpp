@@ -79,11 +79,15 @@ int MatrixNode::serialize(char * buffer, int bufferSize, Preferences::PrintFloat
 
 template<typename T>
 Evaluation<T> MatrixNode::templatedApproximate(Context& context, Preferences::AngleUnit angleUnit) const {
-  MatrixComplex<T> matrix;
+  MatrixComplex<T> matrix(numberOfRows(), numberOfColumns());
+  int i = 0;
   for (ExpressionNode * c : children()) {
-    matrix.addChildAtIndexInPlace(c->approximate(T(), context, angleUnit), matrix.numberOfChildren(), matrix.numberOfChildren());
+    Evaluation<T> coefficient = c->approximate(T(), context, angleUnit);
+    if (coefficient.type() == EvaluationNode<T>::Type::Complex) {
+      matrix.setComplexAtIndex(i, static_cast<Complex<T> &>(coefficient).stdComplex());
+    }
+    i++;
   }
-  matrix.setDimensions(numberOfRows(), numberOfColumns());
   return matrix;
 }
 
@@ -135,7 +139,7 @@ int Matrix::ArrayInverse(T * array, int numberOfRows, int numberOfColumns) {
   assert(numberOfRows*numberOfColumns <= k_maxNumberOfCoefficients);
   int dim = numberOfRows;
   /* Create the matrix inv = (A|I) with A the input matrix and I the dim identity matrix */
-  T operands[k_maxNumberOfCoefficients*(3/2)]; // inv dimensions: dim x (2*dim)
+  T operands[2*k_maxNumberOfCoefficients]; // inv dimensions: dim x (2*dim)
   for (int i = 0; i < dim; i++) {
     for (int j = 0; j < dim; j++) {
       operands[i*2*dim+j] = array[i*numberOfColumns+j];
@@ -159,6 +163,25 @@ int Matrix::ArrayInverse(T * array, int numberOfRows, int numberOfColumns) {
   return 0;
 }
 
+template<typename T>
+void Matrix::ArrayMultiply(const T * a, const T * b, T * result, int m, int n, int p) {
+  assert(result != a && result != b);
+  for (int i = 0; i < m; i++) {
+    T * resultRow = result + i*p;
+    for (int j = 0; j < p; j++) {
+      resultRow[j] = 0.0;
+    }
+    // Go through b row by row, so that the innermost loop reads contiguously
+    for (int k = 0; k < n; k++) {
+      T aik = a[i*n+k];
+      const T * bRow = b + k*p;
+      for (int j = 0; j < p; j++) {
+        resultRow[j] += aik*bRow[j];
+      }
+    }
+  }
+}
+
 Matrix Matrix::rowCanonize(Context & context, Preferences::AngleUnit angleUnit, Multiplication determinant) {
   // The matrix has to be reduced to be able to spot 0 inside it
   Expression reduced = deepReduce(context, angleUnit);
@@ -343,6 +366,8 @@ template int Matrix::ArrayInverse<float>(float *, int, int);
 template int Matrix::ArrayInverse<double>(double *, int, int);
 template int Matrix::ArrayInverse<std::complex<float>>(std::complex<float> *, int, int);
 template int Matrix::ArrayInverse<std::complex<double>>(std::complex<double> *, int, int);
+template void Matrix::ArrayMultiply<std::complex<float>>(const std::complex<float> *, const std::complex<float> *, std::complex<float> *, int, int, int);
+template void Matrix::ArrayMultiply<std::complex<double>>(const std::complex<double> *, const std::complex<double> *, std::complex<double> *, int, int, int);
 template void Matrix::ArrayRowCanonize<std::complex<float> >(std::complex<float>*, int, int, std::complex<float>*);
 template void Matrix::ArrayRowCanonize<std::complex<double> >(std::complex<double>*, int, int, std::complex<double>*);
 
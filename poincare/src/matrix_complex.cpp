@@ -1,52 +1,43 @@
 #include <poincare/matrix_complex.h>
 #include <poincare/matrix.h>
 #include <poincare/expression.h>
-#include <poincare/undefined.h>
 #include <ion.h>
 #include <cmath>
 #include <assert.h>
 #include <float.h>
+#include <string.h>
+#include <utility>
 
 namespace Poincare {
 
 template<typename T>
-void MatrixComplexNode<T>::didAddChildAtIndex(int newNumberOfChildren) {
-  setNumberOfRows(1);
-  setNumberOfColumns(newNumberOfChildren);
+void MatrixComplexNode<T>::setComplexAtIndex(int index, std::complex<T> c) {
+  assert(index >= 0 && index < numberOfCoefficients());
+  // Same as ComplexNode::setComplex
+  if (c.real() == -0) {
+    c.real(0);
+  }
+  if (c.imag() == -0) {
+    c.imag(0);
+  }
+  m_coefficients[index] = c;
 }
 
 template<typename T>
-std::complex<T> MatrixComplexNode<T>::complexAtIndex(int index) const {
-  EvaluationNode<T> * child = EvaluationNode<T>::childAtIndex(index);
-  if (child->type() == EvaluationNode<T>::Type::Complex) {
-    return *(static_cast<ComplexNode<T> *>(child));
-  }
-  return std::complex<T>(NAN, NAN);
+size_t MatrixComplexNode<T>::size() const {
+  return sizeof(MatrixComplexNode<T>) + sizeof(std::complex<T>)*numberOfCoefficients();
 }
 
 template<typename T>
 bool MatrixComplexNode<T>::isUndefined() const {
-  if (numberOfRows() != 1 || numberOfColumns() != 1) {
-    return false;
-  }
-  EvaluationNode<T> * child = const_cast<MatrixComplexNode<T> *>(this)->childAtIndex(0);
-  if (child->type() == EvaluationNode<T>::Type::Complex && std::isnan(static_cast<ComplexNode<T> *>(child)->real()) && std::isnan(static_cast<ComplexNode<T> *>(child)->imag())) {
-    return true;
-  }
-  return false;
+  return numberOfRows() == 1 && numberOfColumns() == 1 && std::isnan(m_coefficients[0].real()) && std::isnan(m_coefficients[0].imag());
 }
 
 template<typename T>
 Expression MatrixComplexNode<T>::complexToExpression(Preferences::ComplexFormat complexFormat) const {
   Matrix matrix = Matrix::EmptyMatrix();
-  int i = 0;
-  for (EvaluationNode<T> * c : this->children()) {
-    if (c->type() == EvaluationNode<T>::Type::Complex) {
-      matrix.addChildAtIndexInPlace(c->complexToExpression(complexFormat), i, i);
-    } else {
-      matrix.addChildAtIndexInPlace(Undefined(), i, i);
-    }
-    i++;
+  for (int i = 0; i < numberOfCoefficients(); i++) {
+    matrix.addChildAtIndexInPlace(ComplexNode<T>::ComplexToExpression(m_coefficients[i], complexFormat), i, i);
   }
   matrix.setDimensions(numberOfRows(), numberOfColumns());
   return matrix;
@@ -70,13 +61,11 @@ std::complex<T> MatrixComplexNode<T>::trace() const {
 
 template<typename T>
 std::complex<T> MatrixComplexNode<T>::determinant() const {
-  if (numberOfRows() != numberOfColumns() || numberOfChildren() == 0 || numberOfChildren() > Matrix::k_maxNumberOfCoefficients) {
+  if (numberOfRows() != numberOfColumns() || numberOfCoefficients() == 0 || numberOfCoefficients() > Matrix::k_maxNumberOfCoefficients) {
     return std::complex<T>(NAN, NAN);
   }
   std::complex<T> operandsCopy[Matrix::k_maxNumberOfCoefficients];
-  for (int i = 0; i < numberOfChildren(); i++) {
-    operandsCopy[i] = complexAtIndex(i); // Returns complex<T>(NAN, NAN) if Node type is not Complex
-  }
+  memcpy(operandsCopy, m_coefficients, numberOfCoefficients()*sizeof(std::complex<T>));
   std::complex<T> determinant = std::complex<T>(1);
   Matrix::ArrayRowCanonize(operandsCopy, m_numberOfRows, m_numberOfColumns, &determinant);
   return determinant;
@@ -84,18 +73,11 @@ std::complex<T> MatrixComplexNode<T>::determinant() const {
 
 template<typename T>
 MatrixComplex<T> MatrixComplexNode<T>::inverse() const {
-  if (numberOfRows() != numberOfColumns() || numberOfChildren() == 0 || numberOfChildren() > Matrix::k_maxNumberOfCoefficients) {
+  if (numberOfRows() != numberOfColumns() || numberOfCoefficients() == 0 || numberOfCoefficients() > Matrix::k_maxNumberOfCoefficients) {
     return MatrixComplex<T>::Undefined();
   }
   std::complex<T> operandsCopy[Matrix::k_maxNumberOfCoefficients];
-  int i = 0;
-  for (EvaluationNode<T> * c : this->children()) {
-    if (c->type() != EvaluationNode<T>::Type::Complex) {
-      return MatrixComplex<T>::Undefined();
-    }
-    operandsCopy[i] = complexAtIndex(i);
-    i++;
-  }
+  memcpy(operandsCopy, m_coefficients, numberOfCoefficients()*sizeof(std::complex<T>));
   int result = Matrix::ArrayInverse(operandsCopy, m_numberOfRows, m_numberOfColumns);
   if (result == 0) {
     /* Intentionally swapping dimensions for inverse, although it doesn't make a
@@ -108,64 +90,121 @@ MatrixComplex<T> MatrixComplexNode<T>::inverse() const {
 template<typename T>
 MatrixComplex<T> MatrixComplexNode<T>::transpose() const {
   // Intentionally swapping dimensions for transpose
-  MatrixComplex<T> result;
+  MatrixComplex<T> result(numberOfColumns(), numberOfRows());
   for (int j = 0; j < numberOfColumns(); j++) {
     for (int i = 0; i < numberOfRows(); i++) {
-      result.addChildAtIndexInPlace(Complex<T>(complexAtIndex(i*numberOfColumns()+j)), result.numberOfChildren(), result.numberOfChildren());
+      result.setComplexAtIndex(j*numberOfRows()+i, complexAtIndex(i*numberOfColumns()+j));
     }
   }
-  result.setDimensions(numberOfColumns(), numberOfRows());
   return result;
 }
 
+template<typename T>
+MatrixComplex<T> MatrixComplexNode<T>::multiply(const MatrixComplexNode<T> * n) const {
+  if (numberOfColumns() != n->numberOfRows()) {
+    return MatrixComplex<T>::Undefined();
+  }
+  MatrixComplex<T> result(numberOfRows(), n->numberOfColumns());
+  /* Creating the result node does not move the operands in the pool: the
+   * product is computed right into its coefficients. */
+  MatrixComplexNode<T> * resultNode = result.node();
+  Matrix::ArrayMultiply(m_coefficients, n->m_coefficients, resultNode->m_coefficients, numberOfRows(), numberOfColumns(), n->numberOfColumns());
+  for (int i = 0; i < resultNode->numberOfCoefficients(); i++) {
+    resultNode->setComplexAtIndex(i, resultNode->m_coefficients[i]);
+  }
+  return result;
+}
+
+template<typename T>
+MatrixComplex<T> MatrixComplexNode<T>::power(int exponent) const {
+  assert(numberOfRows() == numberOfColumns());
+  if (exponent < 0) {
+    return inverse().power(-exponent);
+  }
+  int dim = numberOfRows();
+  // Exponentiation by squaring: the result takes O(log(exponent)) products
+  if (numberOfCoefficients() > Matrix::k_maxNumberOfCoefficients) {
+    MatrixComplex<T> result = MatrixComplex<T>::createIdentity(dim);
+    MatrixComplex<T> square(const_cast<MatrixComplexNode<T> *>(this));
+    while (exponent > 0) {
+      if (Expression::shouldStopProcessing()) {
+        return MatrixComplex<T>::Undefined();
+      }
+      if (exponent & 1) {
+        result = result.multiply(square);
+      }
+      exponent >>= 1;
+      if (exponent > 0) {
+        square = square.multiply(square);
+      }
+    }
+    return result;
+  }
+  std::complex<T> buffers[3][Matrix::k_maxNumberOfCoefficients];
+  std::complex<T> * result = buffers[0];
+  std::complex<T> * square = buffers[1];
+  std::complex<T> * product = buffers[2];
+  for (int i = 0; i < dim; i++) {
+    for (int j = 0; j < dim; j++) {
+      result[i*dim+j] = i == j ? 1.0 : 0.0;
+    }
+  }
+  memcpy(square, m_coefficients, numberOfCoefficients()*sizeof(std::complex<T>));
+  while (exponent > 0) {
+    if (Expression::shouldStopProcessing()) {
+      return MatrixComplex<T>::Undefined();
+    }
+    if (exponent & 1) {
+      Matrix::ArrayMultiply(result, square, product, dim, dim, dim);
+      std::swap(result, product);
+    }
+    exponent >>= 1;
+    if (exponent > 0) {
+      Matrix::ArrayMultiply(square, square, product, dim, dim, dim);
+      std::swap(square, product);
+    }
+  }
+  return MatrixComplex<T>(result, dim, dim);
+}
+
 // MATRIX COMPLEX REFERENCE
 
 template<typename T>
-MatrixComplex<T>::MatrixComplex(std::complex<T> * operands, int numberOfRows, int numberOfColumns) :
-  MatrixComplex<T>()
+MatrixComplex<T>::MatrixComplex(int numberOfRows, int numberOfColumns) :
+  Evaluation<T>(TreePool::sharedPool()->createTreeNode<MatrixComplexNode<T> >(sizeof(MatrixComplexNode<T>) + sizeof(std::complex<T>)*numberOfRows*numberOfColumns))
 {
-  for (int i=0; i<numberOfRows*numberOfColumns; i++) {
-    addChildAtIndexInPlace(Complex<T>(operands[i]), i, i);
+  MatrixComplexNode<T> * n = node();
+  n->setDimensions(numberOfRows, numberOfColumns);
+  for (int i = 0; i < numberOfRows*numberOfColumns; i++) {
+    n->m_coefficients[i] = std::complex<T>(NAN, NAN);
   }
-  setDimensions(numberOfRows, numberOfColumns);
 }
 
 template<typename T>
-MatrixComplex<T>::MatrixComplex() : Evaluation<T>(TreePool::sharedPool()->createTreeNode<MatrixComplexNode<T> >()) {}
+MatrixComplex<T>::MatrixComplex(const std::complex<T> * operands, int numberOfRows, int numberOfColumns) :
+  MatrixComplex<T>(numberOfRows, numberOfColumns)
+{
+  for (int i = 0; i < numberOfRows*numberOfColumns; i++) {
+    setComplexAtIndex(i, operands[i]);
+  }
+}
 
 template<typename T>
 MatrixComplex<T> MatrixComplex<T>::Undefined() {
-  std::complex<T> undef = std::complex<T>(NAN, NAN);
-  return MatrixComplex<T>((std::complex<T> *)&undef, 1, 1);
+  return MatrixComplex<T>(1, 1);
 }
 
 template<typename T>
 MatrixComplex<T> MatrixComplex<T>::createIdentity(int dim) {
-  MatrixComplex<T> result;
+  MatrixComplex<T> result(dim, dim);
   for (int i = 0; i < dim; i++) {
     for (int j = 0; j < dim; j++) {
-      Complex<T> c = i == j ? Complex<T>(1.0) : Complex<T>(0.0);
-      result.addChildAtIndexInPlace(c, i*dim+j, i*dim+j);
+      result.setComplexAtIndex(i*dim+j, i == j ? 1.0 : 0.0);
     }
   }
-  result.setDimensions(dim, dim);
   return result;
 }
 
-template<typename T>
-void MatrixComplex<T>::setDimensions(int rows, int columns) {
-  setNumberOfRows(rows);
-  setNumberOfColumns(columns);
-}
-
-template<typename T>
-void MatrixComplex<T>::addChildAtIndexInPlace(Evaluation<T> t, int index, int currentNumberOfChildren) {
-  if (t.type() != EvaluationNode<T>::Type::Complex) {
-    t = Complex<T>::Undefined();
-  }
-  Evaluation<T>::addChildAtIndexInPlace(t, index, currentNumberOfChildren);
-}
-
 template class MatrixComplexNode<float>;
 template class MatrixComplexNode<double>;
 
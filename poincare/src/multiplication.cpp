@@ -46,21 +46,7 @@ int MultiplicationNode::getPolynomialCoefficients(char symbolName, Expression co
 
 template<typename T>
 MatrixComplex<T> MultiplicationNode::computeOnMatrices(const MatrixComplex<T> m, const MatrixComplex<T> n) {
-  if (m.numberOfColumns() != n.numberOfRows()) {
-    return MatrixComplex<T>::Undefined();
-  }
-  MatrixComplex<T> result;
-  for (int i = 0; i < m.numberOfRows(); i++) {
-    for (int j = 0; j < n.numberOfColumns(); j++) {
-      std::complex<T> c(0.0);
-      for (int k = 0; k < m.numberOfColumns(); k++) {
-        c += m.complexAtIndex(i*m.numberOfColumns()+k)*n.complexAtIndex(k*n.numberOfColumns()+j);
-      }
-      result.addChildAtIndexInPlace(Complex<T>(c), i*n.numberOfColumns()+j, result.numberOfChildren());
-    }
-  }
-  result.setDimensions(m.numberOfRows(), n.numberOfColumns());
-  return result;
+  return m.multiply(n);
 }
 
 Expression MultiplicationNode::setSign(Sign s, Context & context, Preferences::AngleUnit angleUnit) {
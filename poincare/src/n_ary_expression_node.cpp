@@ -1,4 +1,5 @@
 #include <poincare/n_ary_expression_node.h>
+#include <poincare/tree_pool.h>
 extern "C" {
 #include <assert.h>
 #include <stdlib.h>
@@ -7,6 +8,66 @@ extern "C" {
 namespace Poincare {
 
 void NAryExpressionNode::sortChildrenInPlace(ExpressionOrder order, bool canBeInterrupted) {
+  int n = numberOfChildren();
+  if (n < 2) {
+    return;
+  }
+  if (n > k_maxNumberOfChildrenToMergeSort) {
+    sortChildrenInPlaceBySwaps(order, canBeInterrupted);
+    return;
+  }
+  TreeNode * children[k_maxNumberOfChildrenToMergeSort];
+  int i = 0;
+#if MATRIX_EXACT_REDUCING
+  int numberOfMatrices = 0;
+#endif
+  for (TreeNode * c : directChildren()) {
+    children[i++] = c;
+#if MATRIX_EXACT_REDUCING
+    numberOfMatrices += static_cast<ExpressionNode *>(c)->recursivelyMatches(Expression::IsMatrix);
+#endif
+  }
+#if MATRIX_EXACT_REDUCING
+  /* Warning: Matrix operations are not always commutative (ie,
+   * multiplication) so we never swap 2 matrices. A merge sort could move a
+   * matrix across another one: keep the sort by adjacent swaps. */
+  if (numberOfMatrices > 1) {
+    sortChildrenInPlaceBySwaps(order, canBeInterrupted);
+    return;
+  }
+#endif
+  /* Bottom-up merge sort: it is stable, as was the former bubble sort, so
+   * that the children end up in the same order. */
+  TreeNode * buffer[k_maxNumberOfChildrenToMergeSort];
+  TreeNode ** source = children;
+  TreeNode ** destination = buffer;
+  bool isSorted = true;
+  for (int width = 1; width < n; width *= 2) {
+    for (int start = 0; start < n; start += 2*width) {
+      int middle = start + width < n ? start + width : n;
+      int end = start + 2*width < n ? start + 2*width : n;
+      int left = start;
+      int right = middle;
+      for (int k = start; k < end; k++) {
+        if (left < middle && (right >= end || order(static_cast<ExpressionNode *>(source[left]), static_cast<ExpressionNode *>(source[right]), canBeInterrupted) <= 0)) {
+          destination[k] = source[left++];
+        } else {
+          isSorted = isSorted && left == middle;
+          destination[k] = source[right++];
+        }
+      }
+    }
+    TreeNode ** swap = source;
+    source = destination;
+    destination = swap;
+  }
+  if (isSorted) {
+    return;
+  }
+  TreePool::sharedPool()->reorderChildren(this, source, n);
+}
+
+void NAryExpressionNode::sortChildrenInPlaceBySwaps(ExpressionOrder order, bool canBeInterrupted) {
   Expression reference(this);
   for (int i = reference.numberOfChildren()-1; i > 0; i--) {
     bool isSorted = true;
@@ -60,6 +121,15 @@ int NAryExpressionNode::simplificationOrderSameType(const ExpressionNode * e, bo
   return 0;
 }
 
+uint8_t NAryExpressionNode::computeStructuralHash() const {
+  /* A hierarchy with a single child is identical to its child, when compared
+   * to an expression of greater type (see simplificationOrderGreaterType). */
+  if (numberOfChildren() == 1) {
+    return childAtIndex(0)->structuralHash();
+  }
+  return ExpressionNode::computeStructuralHash();
+}
+
 int NAryExpressionNode::simplificationOrderGreaterType(const ExpressionNode * e, bool canBeInterrupted) const {
   int m = numberOfChildren();
   if (m == 0) {
@@ -151,6 +151,15 @@ int PowerNode::simplificationOrderSameType(const ExpressionNode * e, bool canBeI
   return SimplificationOrder(childAtIndex(1), e->childAtIndex(1), canBeInterrupted);
 }
 
+uint8_t PowerNode::computeStructuralHash() const {
+  /* x^1 is identical to x, when compared to an expression of greater type (see
+   * simplificationOrderGreaterType). */
+  if (childAtIndex(1)->structuralHash() == RationalNode::OneStructuralHash()) {
+    return childAtIndex(0)->structuralHash();
+  }
+  return ExpressionNode::computeStructuralHash();
+}
+
 Expression PowerNode::denominator(Context & context, Preferences::AngleUnit angleUnit) const {
   return Power(this).denominator(context, angleUnit);
 }
@@ -168,24 +177,7 @@ template<typename T> MatrixComplex<T> PowerNode::computeOnMatrixAndComplex(const
   if (std::isnan(power) || std::isinf(power) || power != (int)power || std::fabs(power) > k_maxApproximatePowerMatrix) {
     return MatrixComplex<T>::Undefined();
   }
-  if (power < 0) {
-    MatrixComplex<T> inverse = m.inverse();
-    if (inverse.isUninitialized()) {
-      return MatrixComplex<T>::Undefined();
-    }
-    Complex<T> minusC = Complex<T>(-d);
-    MatrixComplex<T> result = PowerNode::computeOnMatrixAndComplex(inverse, minusC.stdComplex());
-    return result;
-  }
-  MatrixComplex<T> result = MatrixComplex<T>::createIdentity(m.numberOfRows());
-  // TODO: implement a quick exponentiation
-  for (int k = 0; k < (int)power; k++) {
-    if (Expression::shouldStopProcessing()) {
-      return MatrixComplex<T>::Undefined();
-    }
-    result = MultiplicationNode::computeOnMatrices<T>(result, m);
-  }
-  return result;
+  return m.power((int)power);
 }
 
 template<typename T> MatrixComplex<T> PowerNode::computeOnMatrices(const MatrixComplex<T> m, const MatrixComplex<T> n) {
@@ -16,6 +16,7 @@ namespace Poincare {
 /* Rational Node */
 
 void RationalNode::setDigits(const native_uint_t * numeratorDigits, uint8_t numeratorSize, const native_uint_t * denominatorDigits, uint8_t denominatorSize, bool negative) {
+  invalidateCachedHash();
   m_negative = negative;
   m_numberOfDigitsNumerator = numeratorSize;
   m_numberOfDigitsDenominator = denominatorSize;
@@ -127,6 +128,35 @@ int RationalNode::simplificationOrderSameType(const ExpressionNode * e, bool can
   return NaturalOrder(this, other);
 }
 
+uint8_t RationalNode::OneStructuralHash() {
+  native_uint_t one = 1;
+  return StructuralHash(false, &one, 1, &one, 1);
+}
+
+uint8_t RationalNode::computeStructuralHash() const {
+  return StructuralHash(m_negative, m_digits, m_numberOfDigitsNumerator, m_digits + m_numberOfDigitsNumerator, m_numberOfDigitsDenominator);
+}
+
+uint8_t RationalNode::StructuralHash(bool negative, const native_uint_t * numeratorDigits, uint8_t numeratorSize, const native_uint_t * denominatorDigits, uint8_t denominatorSize) {
+  uint32_t hash = CombineHash(2166136261, static_cast<uint32_t>(Type::Rational));
+  hash = CombineHash(hash, negative);
+  /* Rationals are irreducible fractions, so that equal rationals have the
+   * same digits. However, with a null or infinite numerator or denominator,
+   * NaturalOrder can find rationals of different digits equal: the digits are
+   * then left out. */
+  if (numeratorSize == 0 || denominatorSize == 0 || numeratorSize > Integer::k_maxNumberOfDigits || denominatorSize > Integer::k_maxNumberOfDigits) {
+    return FoldHash(hash);
+  }
+  hash = CombineHash(hash, numeratorSize);
+  for (int i = 0; i < numeratorSize; i++) {
+    hash = CombineHash(hash, numeratorDigits[i]);
+  }
+  for (int i = 0; i < denominatorSize; i++) {
+    hash = CombineHash(hash, denominatorDigits[i]);
+  }
+  return FoldHash(hash);
+}
+
 // Simplification
 
 Expression RationalNode::shallowReduce(Context & context, Preferences::AngleUnit angleUnit) {
@@ -150,8 +180,10 @@ Rational::Rational(Integer & num, Integer & den) : Number() {
   if (!num.isOne() && !den.isOne()) {
     // Avoid computing GCD if possible
     Integer gcd = Arithmetic::GCD(num, den);
-    num = Integer::Division(num, gcd).quotient;
-    den = Integer::Division(den, gcd).quotient;
+    if (!gcd.isOne()) {
+      num = Integer::Division(num, gcd).quotient;
+      den = Integer::Division(den, gcd).quotient;
+    }
   }
   bool negative = (!num.isNegative() && den.isNegative()) || (!den.isNegative() && num.isNegative());
   new (this) Rational(num.digits(), num.numberOfDigits(), den.digits(), den.numberOfDigits(), negative);
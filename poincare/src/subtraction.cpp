@@ -40,11 +40,10 @@ int SubtractionNode::serialize(char * buffer, int bufferSize, Preferences::Print
 
 template<typename T> MatrixComplex<T> SubtractionNode::computeOnComplexAndMatrix(const std::complex<T> c, const MatrixComplex<T> m) {
   MatrixComplex<T> opposite = computeOnMatrixAndComplex(m, c);
-  MatrixComplex<T> result;
-  for (int i = 0; i < opposite.numberOfChildren(); i++) {
-    result.addChildAtIndexInPlace(OppositeNode::compute(opposite.complexAtIndex(i)), i, i);
+  MatrixComplex<T> result(opposite.numberOfRows(), opposite.numberOfColumns());
+  for (int i = 0; i < opposite.numberOfCoefficients(); i++) {
+    result.setComplexAtIndex(i, OppositeNode::compute(opposite.complexAtIndex(i)).stdComplex());
   }
-  result.setDimensions(opposite.numberOfRows(), opposite.numberOfColumns());
   return result;
 }
 
@@ -79,6 +79,11 @@ int SymbolNode::simplificationOrderSameType(const ExpressionNode * e, bool canBe
   return -1;
 }
 
+uint8_t SymbolNode::computeStructuralHash() const {
+  uint32_t hash = CombineHash(2166136261, static_cast<uint32_t>(type()));
+  return FoldHash(CombineHash(hash, static_cast<uint8_t>(m_name)));
+}
+
 Layout SymbolNode::createLayout(Preferences::PrintFloatMode floatDisplayMode, int numberOfSignificantDigits) const {
   if (m_name == Symbol::SpecialSymbols::Ans) {
     return LayoutHelper::String("ans", 3);
@@ -60,6 +60,7 @@ void TreeHandle::replaceChildInPlace(TreeHandle oldChild, TreeHandle newChild) {
   TreePool::sharedPool()->move(TreePool::sharedPool()->last(), oldChild.node(), oldChild.numberOfChildren());
   oldChild.node()->release(oldChild.numberOfChildren());
   oldChild.deleteParentIdentifier();
+  node()->invalidateCachedHash();
 }
 
 void TreeHandle::replaceChildAtIndexInPlace(int oldChildIndex, TreeHandle newChild) {
@@ -92,6 +93,8 @@ void TreeHandle::mergeChildrenAtIndexInPlace(TreeHandle t, int i) {
     assert(i+j < numberOfChildren());
     childAtIndex(i+j).setParentIdentifier(identifier());
   }
+  t.node()->invalidateCachedHash();
+  node()->invalidateCachedHash();
   // If t is a child, remove it
   if (node()->hasChild(t.node())) {
     removeChildInPlace(t, 0);
@@ -110,6 +113,7 @@ void TreeHandle::swapChildrenInPlace(int i, int j) {
   TreeHandle secondChild = childAtIndex(secondChildIndex);
   TreePool::sharedPool()->move(firstChild.node()->nextSibling(), secondChild.node(), secondChild.numberOfChildren());
   TreePool::sharedPool()->move(childAtIndex(secondChildIndex).node()->nextSibling(), firstChild.node(), firstChild.numberOfChildren());
+  node()->invalidateCachedHash();
 }
 
 #if POINCARE_TREE_LOG
@@ -142,6 +146,7 @@ void TreeHandle::addChildAtIndexInPlace(TreeHandle t, int index, int currentNumb
   t.setParentIdentifier(identifier());
 
   node()->didAddChildAtIndex(currentNumberOfChildren+1);
+  node()->invalidateCachedHash();
 }
 
 // Remove
@@ -159,12 +164,14 @@ void TreeHandle::removeChildInPlace(TreeHandle t, int childNumberOfChildren) {
   t.node()->release(childNumberOfChildren);
   t.deleteParentIdentifier();
   node()->decrementNumberOfChildren();
+  node()->invalidateCachedHash();
 }
 
 void TreeHandle::removeChildrenInPlace(int currentNumberOfChildren) {
   assert(!isUninitialized());
   deleteParentIdentifierInChildren();
   TreePool::sharedPool()->removeChildren(node(), currentNumberOfChildren);
+  node()->invalidateCachedHash();
 }
 
 /* Private */
@@ -28,6 +28,17 @@ void TreeNode::rename(int identifier, bool unregisterPreviousIdentifier) {
   updateParentIdentifierInChildren();
 }
 
+void TreeNode::invalidateCachedHash() {
+  /* The hashes of the ancestors depend on this node. As the nodes with a
+   * cached hash only have descendants with a cached hash, we can stop at the
+   * first ancestor without one. */
+  TreeNode * node = this;
+  while (node != nullptr && node->hasCachedHash()) {
+    node->m_cachedHash = k_noCachedHash;
+    node = node->parent();
+  }
+}
+
 // Hierarchy
 
 TreeNode * TreeNode::parent() const {
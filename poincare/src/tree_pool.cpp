@@ -10,7 +10,7 @@
 
 namespace Poincare {
 
-TreePool * TreePool::SharedStaticPool;
+POINCARE_THREAD_LOCAL TreePool * TreePool::SharedStaticPool;
 
 void TreePool::freeIdentifier(int identifier) {
   if (identifier >= 0 && identifier < MaxNumberOfNodes) {
@@ -49,6 +49,46 @@ void TreePool::removeChildren(TreeNode * node, int nodeNumberOfChildren) {
   node->eraseNumberOfChildren();
 }
 
+void TreePool::reorderChildren(TreeNode * node, TreeNode ** orderedChildren, int numberOfChildren) {
+  assert(numberOfChildren == node->numberOfChildren());
+  char * childrenStart = reinterpret_cast<char *>(node->next());
+  size_t childrenSize = node->deepSize(-1) - node->size();
+  if (m_cursor + childrenSize <= m_buffer + BufferSize) {
+    /* Lay the children out in order in the free space at the end of the pool,
+     * and copy them back at once. */
+    char * destination = m_cursor;
+    for (int i = 0; i < numberOfChildren; i++) {
+      size_t childSize = orderedChildren[i]->deepSize(-1);
+      memcpy(destination, orderedChildren[i], childSize);
+      destination += childSize;
+    }
+    memcpy(childrenStart, m_cursor, childrenSize);
+    TreeNode * childrenEnd = reinterpret_cast<TreeNode *>(childrenStart + childrenSize);
+    for (TreeNode * n = reinterpret_cast<TreeNode *>(childrenStart); n < childrenEnd; n = n->next()) {
+      m_nodeForIdentifier[n->identifier()] = n;
+    }
+    node->invalidateCachedHash();
+    return;
+  }
+  /* Not enough free space: move the children one by one in front of the
+   * children left to place. */
+  TreeNode * destination = node->next();
+  for (int i = 0; i < numberOfChildren; i++) {
+    TreeNode * child = orderedChildren[i];
+    assert(child >= destination);
+    size_t childSize = child->deepSize(-1);
+    move(destination, child, -1);
+    // The nodes between destination and the child were shifted by childSize
+    for (int j = i+1; j < numberOfChildren; j++) {
+      if (orderedChildren[j] < child) {
+        orderedChildren[j] = reinterpret_cast<TreeNode *>(reinterpret_cast<char *>(orderedChildren[j]) + childSize);
+      }
+    }
+    destination = reinterpret_cast<TreeNode *>(reinterpret_cast<char *>(destination) + childSize);
+  }
+  node->invalidateCachedHash();
+}
+
 TreeNode * TreePool::deepCopy(TreeNode * node) {
   size_t size = node->deepSize(-1);
   return copyTreeFromAddress(static_cast<void *>(node), size);
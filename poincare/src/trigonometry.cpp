@@ -8,6 +8,7 @@
 #include <poincare/derivative.h>
 #include <poincare/decimal.h>
 #include <poincare/float.h>
+#include <poincare/thread_local.h>
 #include <ion.h>
 #include <assert.h>
 #include <cmath>
@@ -223,20 +224,16 @@ Expression Trigonometry::shallowReduceInverseFunction(Expression & e, Context& c
   return e;
 }
 
-/* TODO: We use the cheat table to look for known simplifications (e.g.
- * cos(0)=1). To look for a simplification, we parse, simplify and compare all
- * known values to the input expression, which is slow. To make this faster, we
- * have several options:
- * - Compare double values instead of trees (a hash table)
- * - Store parsed Trees and compare buffers:
- *   - By parsing all expressions at initialization and storing them (takes a
- *     lot of RAM)
- *   - By having constexpr constructor of TreeNodes (not possible because
- *     TreeNode has a virtual destructor) and storing Trees in Flash memory
- * - Use a prefix Tree to search for a match (also called Trie) */
+/* We use the cheat table to look for known simplifications (e.g.
+ * cos(0)=1). Parsing and reducing every entry of the table on each lookup is
+ * slow, and storing the reduced trees would take a lot of RAM (TreeNodes
+ * cannot be built in Flash as they have a virtual destructor). Instead, the
+ * approximations of all the entries are computed once. A lookup approximates
+ * the expression and only parses and compares the trees of the entries with
+ * the same value, which is usually a single one. */
 
 static_assert('\x8A' == Ion::Charset::SmallPi, "Unicode error");
-constexpr const char * cheatTable[Trigonometry::k_numberOfEntries][5] =
+constexpr const char * cheatTable[Trigonometry::k_numberOfEntries][Trigonometry::k_numberOfColumns] =
 // Angle in Radian | Angle in Degree | Cosine | Sine | Tangent
 {{"-90",    "\x8A*(-2)^(-1)",    "",                                   "-1",                                 "undef"},
  {"-75",    "\x8A*(-5)*12^(-1)", "",                                   "(-1)*6^(1/2)*4^(-1)-2^(1/2)*4^(-1)", "-(3^(1/2)+2)"},
@@ -299,7 +296,16 @@ Expression Trigonometry::table(const Expression e, ExpressionNode::Type type, Co
   if (inputIndex >1 && e.type() != ExpressionNode::Type::Rational && e.type() != ExpressionNode::Type::Multiplication && e.type() != ExpressionNode::Type::Power && e.type() != ExpressionNode::Type::Addition) {
     return Expression();
   }
+  const float * values = cheatTableValues(context, angleUnit);
+  double value = e.approximateToScalar<double>(context, angleUnit);
+  if (std::isnan(value)) {
+    return Expression();
+  }
   for (int i = 0; i < k_numberOfEntries; i++) {
+    float entryValue = values[i*k_numberOfColumns+inputIndex];
+    if (std::isnan(entryValue) || std::fabs(value - entryValue) > k_cheatTableValuePrecision*(1.0+std::fabs(value))) {
+      continue;
+    }
     Expression input = Expression::parse(cheatTable[i][inputIndex]);
     if (input.isUninitialized()) {
       continue;
@@ -317,6 +323,22 @@ Expression Trigonometry::table(const Expression e, ExpressionNode::Type type, Co
   return Expression();
 }
 
+const float * Trigonometry::cheatTableValues(Context & context, Preferences::AngleUnit angleUnit) {
+  static POINCARE_THREAD_LOCAL float sValues[k_numberOfEntries*k_numberOfColumns];
+  static POINCARE_THREAD_LOCAL bool sValuesAreComputed = false;
+  if (!sValuesAreComputed) {
+    for (int i = 0; i < k_numberOfEntries; i++) {
+      for (int j = 0; j < k_numberOfColumns; j++) {
+        Expression entry = Expression::parse(cheatTable[i][j]);
+        // The entries only involve numbers and π: the angle unit is irrelevant
+        sValues[i*k_numberOfColumns+j] = entry.isUninitialized() ? NAN : entry.approximateToScalar<float>(context, angleUnit);
+      }
+    }
+    sValuesAreComputed = true;
+  }
+  return sValues;
+}
+
 template <typename T>
 std::complex<T> Trigonometry::ConvertToRadian(const std::complex<T> c, Preferences::AngleUnit angleUnit) {
   if (angleUnit == Preferences::AngleUnit::Degree) {
@@ -357,5 +379,7 @@ template std::complex<float> Trigonometry::ConvertRadianToAngleUnit<float>(std::
 template std::complex<double> Trigonometry::ConvertRadianToAngleUnit<double>(std::complex<double>, Preferences::AngleUnit);
 template std::complex<float> Trigonometry::RoundToMeaningfulDigits<float>(std::complex<float>);
 template std::complex<double> Trigonometry::RoundToMeaningfulDigits<double>(std::complex<double>);
+template float Trigonometry::RoundToMeaningfulDigits<float>(float);
+template double Trigonometry::RoundToMeaningfulDigits<double>(double);
 
 }
@@ -86,3 +86,17 @@ QUIZ_CASE(poincare_addition_simplify) {
   assert_parsed_expression_simplify_to("4x/x^2+3P/(x^3*P)", "(3+4*x^2)/x^3");
   assert_parsed_expression_simplify_to("3^(1/2)+2^(-2*3^(1/2)*X^P)/2", "(1+2*2^(2*R(3)*X^P)*R(3))/(2*2^(2*R(3)*X^P))");
 }
+
+QUIZ_CASE(poincare_addition_sort_children) {
+  // Many children, so that most of them move
+  constexpr int n = 61;
+  Addition a;
+  for (int i = 0; i < n; i++) {
+    a.addChildAtIndexInPlace(Power(Symbol('x'), Rational((i*17)%n)), i, i);
+  }
+  a.sortChildrenInPlace(ExpressionNode::SimplificationOrder, false);
+  quiz_assert(a.numberOfChildren() == n);
+  for (int i = 0; i < n; i++) {
+    quiz_assert(a.childAtIndex(i).isIdenticalTo(Power(Symbol('x'), Rational(i))));
+  }
+}
@@ -70,6 +70,15 @@ QUIZ_CASE(poincare_arithmetic) {
   assert_gcd_equals_to(Integer(-8), Integer(-40), Integer(8));
   assert_gcd_equals_to(Integer("1234567899876543456"), Integer("234567890098765445678"), Integer(2));
   assert_gcd_equals_to(Integer("45678998789"), Integer("1461727961248"), Integer("45678998789"));
+  assert_gcd_equals_to(Integer(0), Integer(-5), Integer(5));
+  assert_gcd_equals_to(Integer("9223372036854775808"), Integer("3298534883328"), Integer("1099511627776"));
+  assert_gcd_equals_to(Integer("137347080577163115432025771710279131845700275212767467264610201"), Integer("222232244629420445529739893461909967206666939096499764990979600"), Integer("1"));
+  assert_gcd_equals_to(Integer("387381625547900583936"), Integer("90905554795240670363648"), Integer("129127208515966861312"));
+  assert_gcd_equals_to(Integer("10000000000000000000000000000000000000001"), Integer("100000000000000000001"), Integer("1"));
+  assert_gcd_equals_to(Integer("540082282802526138903746835830703648667580760"), Integer("1134186386867876939335297318981832165807446185289641907904591175509516509213817264834012804034999052098614641377201278717221394556272300688448785275351442242866713610"), Integer("248289021900363196427360330"));
+  assert_gcd_equals_to(Integer("4816857160934741586158197387904302975151779232982019851695047685141249375434040288879602821523141768879997776127879741324968882799643967214729"), Integer("4053371552121726781149689323492096844568350316071345509275108926834730407271617708796947307065403177240069563950223934773803"), Integer("1459267"));
+  assert_gcd_equals_to(Integer("2339471766611349632479134957147251499413534661808868607705823968963423495107764591599943439530474553551025130785256709581406910512475686173338203589765453106622628142489475536330234240"), Integer("16715264167032703446106985292544715879808508428380482874592964351524638965457584817618497346987364936960536373807020100784300873439232"), Integer("530234374990882260195122390165251627668096"));
+  assert_gcd_equals_to(Integer("319327483015556275167300069609572246879635035017680894283639668149180459542207366371420305088762866933492701701297538996218756913334843020003245030456173763082906279228640194755120575615324358073707482266611188322498900135242"), Integer("479565990741843880031352042386268471936474458766983329491009358787706864799476667310463600150768933377888740759363377559079057143912362019356557417124723848875046351916127926318285062651235389650803494679701101516184850237903750198970592154"), Integer("64873292602538622996993584934197899576511550872048530712162437120508406"));
   assert_lcm_equals_to(Integer(11), Integer(121), Integer(121));
   assert_lcm_equals_to(Integer(-31), Integer(52), Integer(1612));
   assert_lcm_equals_to(Integer(-8), Integer(-40), Integer(40));
@@ -87,4 +96,32 @@ QUIZ_CASE(poincare_arithmetic) {
   int factors3[7] = {3,7,11, 13, 19, 3607, 3803};
   int coefficients3[7] = {4,2,2,2,2,2,2};
   assert_prime_factorization_equals_to(Integer("5513219850886344455940081"), factors3, coefficients3, 7);
+  // Prime factors above the primes table
+  int factors4[3] = {2, 7919, 10007};
+  int coefficients4[3] = {1, 1, 3};
+  assert_prime_factorization_equals_to(Integer("15871283087292434"), factors4, coefficients4, 3);
+  int factors5[2] = {1000003, 1000033};
+  int coefficients5[2] = {1, 1};
+  assert_prime_factorization_equals_to(Integer("1000036000099"), factors5, coefficients5, 2);
+  int factors6[2] = {998244353, 1000000007};
+  int coefficients6[2] = {1, 1};
+  assert_prime_factorization_equals_to(Integer("998244359987710471"), factors6, coefficients6, 2);
+  // 2^89-1 is prime
+  Integer factors7[1];
+  Integer coefficients7[1];
+  quiz_assert(Arithmetic::PrimeFactorization(Integer("618970019642690137449562111"), factors7, coefficients7, 1) == 1);
+  quiz_assert(factors7[0].isEqualTo(Integer("618970019642690137449562111")) && coefficients7[0].isOne());
+  // Repeated large prime factors are merged as they are found
+  Integer factors9[1];
+  Integer coefficients9[1];
+  quiz_assert(Arithmetic::PrimeFactorization(Integer::Power(Integer(10007), Integer(5)), factors9, coefficients9, 1) == 1);
+  quiz_assert(factors9[0].isEqualTo(Integer(10007)) && coefficients9[0].isEqualTo(Integer(5)));
+  // Large prime factors which do not fit in the output
+  Integer factors10[1];
+  Integer coefficients10[1];
+  quiz_assert(Arithmetic::PrimeFactorization(Integer("1000036000099"), factors10, coefficients10, 1) == -2);
+  // Two 20-digit prime factors take too many steps of Pollard's rho
+  Integer factors8[2];
+  Integer coefficients8[2];
+  quiz_assert(Arithmetic::PrimeFactorization(Integer::Multiplication(Integer("18446744073709551629"), Integer("18446744073709551653")), factors8, coefficients8, 2) == -2);
 }
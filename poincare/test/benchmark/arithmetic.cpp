@@ -0,0 +1,69 @@
+#include <quiz_benchmark.h>
+#include <poincare.h>
+#include <poincare/arithmetic.h>
+#include <stdio.h>
+
+using namespace Poincare;
+
+static void print_duration(const char * name, double duration) {
+  char buffer[128];
+  snprintf(buffer, sizeof(buffer), "%s: %.0f ns", name, duration);
+  quiz_print(buffer);
+}
+
+QUIZ_CASE(poincare_benchmark_arithmetic) {
+  Integer a(123456);
+  Integer b(7890);
+  print_duration("gcd(123456,7890)", quiz_benchmark(2000, [&]() {
+      Arithmetic::GCD(a, b);
+    }));
+  Integer c("1234567899876543456");
+  Integer d("234567890098765445678");
+  print_duration("gcd of 2 and 3 digits", quiz_benchmark(2000, [&]() {
+      Arithmetic::GCD(c, d);
+    }));
+  // Consecutive Fibonacci numbers are the worst case of Euclid's algorithm
+  Integer f299("222232244629420445529739893461909967206666939096499764990979600");
+  Integer f300("359579325206583560961765665172189099052367214309267232255589801");
+  print_duration("gcd(F(299),F(300))", quiz_benchmark(200, [&]() {
+      Arithmetic::GCD(f299, f300);
+    }));
+  Integer g = Integer::Multiplication(Integer::Factorial(Integer(40)), Integer("1000000007"));
+  Integer h = Integer::Multiplication(Integer::Factorial(Integer(41)), Integer("998244353"));
+  print_duration("gcd(40!*p,41!*q)", quiz_benchmark(200, [&]() {
+      Arithmetic::GCD(g, h);
+    }));
+  print_duration("lcm(40!*p,41!*q)", quiz_benchmark(200, [&]() {
+      Arithmetic::LCM(g, h);
+    }));
+  Integer factors[Arithmetic::k_maxNumberOfPrimeFactors];
+  Integer coefficients[Arithmetic::k_maxNumberOfPrimeFactors];
+  Integer n0(6252060);
+  print_duration("factorize 6252060", quiz_benchmark(200, [&]() {
+      Arithmetic::PrimeFactorization(n0, factors, coefficients, Arithmetic::k_maxNumberOfPrimeFactors);
+    }));
+  Integer n1("5513219850886344455940081");
+  print_duration("factorize 5513219850886344455940081", quiz_benchmark(200, [&]() {
+      Arithmetic::PrimeFactorization(n1, factors, coefficients, Arithmetic::k_maxNumberOfPrimeFactors);
+    }));
+  Integer n2("1000036000099");
+  print_duration("factorize 1000003*1000033", quiz_benchmark(20, [&]() {
+      Arithmetic::PrimeFactorization(n2, factors, coefficients, Arithmetic::k_maxNumberOfPrimeFactors);
+    }));
+  Integer n3("618970019642690137449562111");
+  print_duration("factorize 2^89-1", quiz_benchmark(20, [&]() {
+      Arithmetic::PrimeFactorization(n3, factors, coefficients, Arithmetic::k_maxNumberOfPrimeFactors);
+    }));
+  // Pollard's rho runs out of steps
+  Integer n4 = Integer::Multiplication(Integer("18446744073709551629"), Integer("18446744073709551653"));
+  print_duration("factorize two 20-digit primes", quiz_benchmark(2, [&]() {
+      Arithmetic::PrimeFactorization(n4, factors, coefficients, Arithmetic::k_maxNumberOfPrimeFactors);
+    }));
+  GlobalContext globalContext;
+  print_duration("simplify 1/2+1/3+...+1/20", quiz_benchmark(20, [&]() {
+      Expression::ParseAndSimplify("1/2+1/3+1/4+1/5+1/6+1/7+1/8+1/9+1/10+1/11+1/12+1/13+1/14+1/15+1/16+1/17+1/18+1/19+1/20", globalContext, Preferences::AngleUnit::Radian);
+    }));
+  print_duration("simplify rational coefficients of x", quiz_benchmark(20, [&]() {
+      Expression::ParseAndSimplify("2/3*x+5/7*x-11/13*x+17/19*x^2-23/29*x^2+31/37*x^3+41/43*x^3-47/53", globalContext, Preferences::AngleUnit::Radian);
+    }));
+}
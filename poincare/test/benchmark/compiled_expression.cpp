@@ -0,0 +1,45 @@
+#include <quiz_benchmark.h>
+#include <poincare.h>
+#include "../helper.h"
+
+using namespace Poincare;
+
+static void benchmark_compiled_expression(const char * expression, Preferences::AngleUnit angleUnit = Radian) {
+  GlobalContext globalContext;
+  char buffer[200];
+  strlcpy(buffer, expression, sizeof(buffer));
+  translate_in_special_chars(buffer);
+  Expression e = Expression::ParseAndSimplify(buffer, globalContext, angleUnit);
+  CompiledExpression<double> c(e, 'x', globalContext, angleUnit);
+  constexpr int k_numberOfSamples = 320;
+  double x = -10.0;
+  double sum = 0.0;
+  double tree = quiz_benchmark(k_numberOfSamples, [&]() {
+      sum += e.approximateWithValueForSymbol('x', x, globalContext, angleUnit);
+      x += 20.0/k_numberOfSamples;
+    });
+  x = -10.0;
+  double compiled = quiz_benchmark(k_numberOfSamples, [&]() {
+      sum += c.approximateWithValueForSymbol(x, globalContext);
+      x += 20.0/k_numberOfSamples;
+    });
+  quiz_benchmark_print(expression, tree, compiled);
+
+  double abscissae[k_numberOfSamples];
+  double results[k_numberOfSamples];
+  for (int i = 0; i < k_numberOfSamples; i++) {
+    abscissae[i] = -10.0 + i*20.0/k_numberOfSamples;
+  }
+  double batch = quiz_benchmark(1, [&]() {
+      c.approximateWithValuesForSymbol(abscissae, results, k_numberOfSamples, globalContext);
+    })/k_numberOfSamples;
+  quiz_benchmark_print("  batch", compiled, batch);
+}
+
+QUIZ_CASE(poincare_benchmark_compiled_expression) {
+  benchmark_compiled_expression("x^2-3*x+1");
+  benchmark_compiled_expression("sin(x)*cos(2*x)+tan(x)");
+  benchmark_compiled_expression("cos(90*x)", Degree);
+  benchmark_compiled_expression("R(x)+ln(x)");
+  benchmark_compiled_expression("P*x+X^(x/10)");
+}
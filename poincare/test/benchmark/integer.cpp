@@ -0,0 +1,57 @@
+#include <quiz_benchmark.h>
+#include <poincare.h>
+#include <stdio.h>
+
+using namespace Poincare;
+
+static void print_duration(const char * name, double duration) {
+  char buffer[128];
+  snprintf(buffer, sizeof(buffer), "%s: %.0f ns", name, duration);
+  quiz_print(buffer);
+}
+
+// binomial(n,k) = prod((n-k+i)/i), each partial product being an integer
+static Integer binomial(int n, int k) {
+  Integer result(1);
+  for (int i = 1; i <= k; i++) {
+    result = Integer::Multiplication(result, Integer(n-k+i));
+    result = Integer::Division(result, Integer(i)).quotient;
+  }
+  return result;
+}
+
+QUIZ_CASE(poincare_benchmark_integer) {
+  Integer hundred(100);
+  print_duration("100!", quiz_benchmark(200, [&]() {
+      Integer::Factorial(hundred);
+    }));
+  print_duration("binomial(200,100)", quiz_benchmark(200, [&]() {
+      binomial(200, 100);
+    }));
+  Integer base("123456789123456789123456789");
+  Integer exponent(11);
+  print_duration("123456789123456789123456789^11", quiz_benchmark(200, [&]() {
+      Integer::Power(base, exponent);
+    }));
+  Rational r("98765432123456789", "1234567891011");
+  print_duration("(98765432123456789/1234567891011)^8", quiz_benchmark(200, [&]() {
+      Rational::IntegerPower(r, Integer(8));
+    }));
+  Integer a = Integer::Power(Integer("340282366920938463463374607431768211457"), Integer(3));
+  Integer b = Integer::Power(Integer("18446744073709551629"), Integer(3));
+  print_duration("16 digits * 6 digits", quiz_benchmark(2000, [&]() {
+      Integer::Multiplication(a, b);
+    }));
+  Integer c = Integer::Multiplication(a, a);
+  print_duration("24 digits / 12 digits", quiz_benchmark(2000, [&]() {
+      Integer::Division(c, Integer::Multiplication(b, b));
+    }));
+  Integer fact = Integer::Factorial(hundred);
+  char buffer[400];
+  print_duration("serialize 100!", quiz_benchmark(200, [&]() {
+      fact.serialize(buffer, sizeof(buffer));
+    }));
+  print_duration("number of base 10 digits of 100!", quiz_benchmark(200, [&]() {
+      Integer::NumberOfBase10DigitsWithoutSign(fact);
+    }));
+}
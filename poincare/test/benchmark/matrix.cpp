@@ -0,0 +1,33 @@
+#include <quiz_benchmark.h>
+#include <poincare.h>
+#include <stdio.h>
+
+using namespace Poincare;
+
+static void print_duration(const char * name, double duration) {
+  char buffer[128];
+  snprintf(buffer, sizeof(buffer), "%s: %.0f ns", name, duration);
+  quiz_print(buffer);
+}
+
+static void benchmark_approximation(const char * name, const char * expression, int numberOfIterations) {
+  GlobalContext globalContext;
+  Expression e = Expression::parse(expression);
+  print_duration(name, quiz_benchmark(numberOfIterations, [&]() {
+      e.approximate<double>(globalContext, Preferences::AngleUnit::Radian, Preferences::ComplexFormat::Cartesian);
+    }));
+}
+
+QUIZ_CASE(poincare_benchmark_matrix) {
+  const char * m5 = "[[0.1,0.2,0,0,0.1][0,0.3,0.1,0.2,0][0.2,0,0.1,0,0.3][0,0.1,0,0.4,0][0.1,0,0.2,0,0.2]]";
+  char expression[256];
+  snprintf(expression, sizeof(expression), "%s*%s", m5, m5);
+  benchmark_approximation("5x5 * 5x5", expression, 100);
+  snprintf(expression, sizeof(expression), "%s^100", m5);
+  benchmark_approximation("5x5^100", expression, 20);
+  snprintf(expression, sizeof(expression), "%s^(-20)", m5);
+  benchmark_approximation("5x5^(-20)", expression, 20);
+  snprintf(expression, sizeof(expression), "cos(%s)+2*%s", m5, m5);
+  benchmark_approximation("cos(5x5)+2*5x5", expression, 100);
+  benchmark_approximation("[[1,2,3,4,5,6,7,8,9,10]]*[[1][2][3][4][5][6][7][8][9][10]]", "[[1,2,3,4,5,6,7,8,9,10]]*[[1][2][3][4][5][6][7][8][9][10]]", 100);
+}
@@ -0,0 +1,50 @@
+#include <quiz_benchmark.h>
+#include <poincare.h>
+
+using namespace Poincare;
+
+static int order(const Expression & e1, const Expression & e2) {
+  return ExpressionNode::SimplificationOrder(static_cast<ExpressionNode *>(static_cast<const TreeHandle &>(e1).node()), static_cast<ExpressionNode *>(static_cast<const TreeHandle &>(e2).node()), false);
+}
+
+// The former bubble sort, as a reference
+static void bubble_sort(Addition a) {
+  for (int i = a.numberOfChildren()-1; i > 0; i--) {
+    bool isSorted = true;
+    for (int j = 0; j < a.numberOfChildren()-1; j++) {
+      if (order(a.childAtIndex(j), a.childAtIndex(j+1)) > 0) {
+        a.swapChildrenInPlace(j, j+1);
+        isSorted = false;
+      }
+    }
+    if (isSorted) {
+      return;
+    }
+  }
+}
+
+static void benchmark_sort(const char * name, int numberOfTerms) {
+  // Rational terms, in a scrambled order
+  Addition a;
+  for (int i = 0; i < numberOfTerms; i++) {
+    a.addChildAtIndexInPlace(Rational((i*37)%numberOfTerms), i, i);
+  }
+  int numberOfIterations = 2000/numberOfTerms;
+  double bubble = quiz_benchmark(numberOfIterations, [&]() {
+      Expression c = a.clone();
+      Addition b = static_cast<Addition &>(c);
+      bubble_sort(b);
+    });
+  double merge = quiz_benchmark(numberOfIterations, [&]() {
+      Expression c = a.clone();
+      Addition b = static_cast<Addition &>(c);
+      b.sortChildrenInPlace(ExpressionNode::SimplificationOrder, false);
+    });
+  quiz_benchmark_print(name, bubble, merge);
+}
+
+QUIZ_CASE(poincare_benchmark_n_ary_sort) {
+  benchmark_sort("sort 50 terms", 50);
+  benchmark_sort("sort 100 terms", 100);
+  benchmark_sort("sort 200 terms", 200);
+}
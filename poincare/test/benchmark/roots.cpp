@@ -0,0 +1,38 @@
+#include <quiz_benchmark.h>
+#include <poincare.h>
+#include <cmath>
+#include "../helper.h"
+
+using namespace Poincare;
+
+static void benchmark_roots(const char * name, const char * expression, double min, double max) {
+  GlobalContext globalContext;
+  char buffer[100];
+  strlcpy(buffer, expression, sizeof(buffer));
+  translate_in_special_chars(buffer);
+  Expression e = Expression::parse(buffer);
+  constexpr int maxNumberOfRoots = 10;
+  double step = (max-min)/100.0;
+  // Successive calls to nextRoot, as a reference
+  double successive = quiz_benchmark(5, [&]() {
+      double start = min;
+      for (int i = 0; i <= maxNumberOfRoots; i++) {
+        double root = e.nextRoot('x', start, step, max, globalContext, Radian);
+        if (std::isnan(root)) {
+          break;
+        }
+        start = root;
+      }
+    });
+  double scan = quiz_benchmark(5, [&]() {
+      double roots[maxNumberOfRoots+1];
+      e.nextRoots('x', min, step, max, roots, maxNumberOfRoots+1, globalContext, Radian);
+    });
+  quiz_benchmark_print(name, successive, scan);
+}
+
+QUIZ_CASE(poincare_benchmark_roots) {
+  benchmark_roots("roots of sin(x) on [-100,100]", "sin(x)", -100.0, 100.0);
+  benchmark_roots("roots of x^3-x on [-10,10]", "x^3-x", -10.0, 10.0);
+  benchmark_roots("roots of cos(x)-1 on [-10,40]", "cos(x)-1", -10.0, 40.0);
+}
@@ -0,0 +1,66 @@
+#include <quiz_benchmark.h>
+#include <poincare.h>
+#include <thread>
+#include <stdio.h>
+#include <string.h>
+#include "../helper.h"
+
+using namespace Poincare;
+
+static const char * const sCorpus[] = {
+  "2^100*3^50-6^50",
+  "(x+1)^3-(x-1)^3",
+  "1/(R(2)+R(3))+1/(R(3)-R(2))",
+  "binomial(30,15)/10!",
+  "ln(8)/ln(2)+cos(P/3)+sin(P/4)^2",
+  "[[1,2][3,4]]^3",
+  "(2x+3)/(x+1)-2",
+  "X^(ln(5))*R(50)/R(2)",
+  "diff(x^3,2)+int(x,0,2)",
+  "123456789*987654321/3^12",
+};
+constexpr static int sCorpusSize = sizeof(sCorpus)/sizeof(const char *);
+constexpr static int k_numberOfRuns = 32;
+
+// Simplify the corpus numberOfRuns times in the pool of the calling thread
+static void simplify_corpus(int numberOfRuns) {
+  GlobalContext context;
+  for (int run = 0; run < numberOfRuns; run++) {
+    for (int i = 0; i < sCorpusSize; i++) {
+      char buffer[100];
+      strlcpy(buffer, sCorpus[i], sizeof(buffer));
+      translate_in_special_chars(buffer);
+      Expression e = Expression::parse(buffer);
+      e = e.simplify(context, Preferences::AngleUnit::Radian);
+    }
+  }
+}
+
+// Share k_numberOfRuns runs of the corpus between numberOfThreads workers
+static void simplify_corpus_on_threads(int numberOfThreads) {
+  constexpr int k_maxNumberOfThreads = 8;
+  std::thread threads[k_maxNumberOfThreads];
+  for (int t = 0; t < numberOfThreads; t++) {
+    int numberOfRuns = k_numberOfRuns/numberOfThreads + (t < k_numberOfRuns%numberOfThreads);
+    threads[t] = std::thread([numberOfRuns]() {
+        ThreadContext threadContext;
+        simplify_corpus(numberOfRuns);
+      });
+  }
+  for (int t = 0; t < numberOfThreads; t++) {
+    threads[t].join();
+  }
+}
+
+QUIZ_CASE(poincare_benchmark_thread_context) {
+  double oneThread = quiz_benchmark(3, []() { simplify_corpus_on_threads(1); });
+  char name[64];
+  snprintf(name, sizeof(name), "hardware threads: %u", std::thread::hardware_concurrency());
+  quiz_print(name);
+  const int numbersOfThreads[] = {2, 4, 8};
+  for (int n : numbersOfThreads) {
+    double nThreads = quiz_benchmark(3, [n]() { simplify_corpus_on_threads(n); });
+    snprintf(name, sizeof(name), "simplify corpus on %d threads", n);
+    quiz_benchmark_print(name, oneThread, nThreads);
+  }
+}
@@ -0,0 +1,115 @@
+#include <quiz.h>
+#include <poincare.h>
+#include <cmath>
+#include <assert.h>
+#include "helper.h"
+
+using namespace Poincare;
+
+template<typename T>
+void assert_compiled_expression_approximates_as_tree(const char * expression, const T * abscissae, int numberOfAbscissae, bool compiled = true, Preferences::AngleUnit angleUnit = Radian) {
+  GlobalContext globalContext;
+  char buffer[200];
+  strlcpy(buffer, expression, sizeof(buffer));
+  translate_in_special_chars(buffer);
+  Expression e = Expression::ParseAndSimplify(buffer, globalContext, angleUnit);
+  CompiledExpression<T> c(e, 'x', globalContext, angleUnit);
+  quiz_assert(c.isCompiled() == compiled);
+  for (int i = 0; i < numberOfAbscissae; i++) {
+    T expected = e.approximateWithValueForSymbol<T>('x', abscissae[i], globalContext, angleUnit);
+    T result = c.approximateWithValueForSymbol(abscissae[i], globalContext);
+    if (std::isnan(expected)) {
+      quiz_assert(std::isnan(result));
+    } else if (result != expected) {
+      T precision = sizeof(T) == sizeof(double) ? 1E-13 : 1E-5;
+      quiz_assert(std::fabs(result - expected) <= precision*std::fabs(expected) || std::fabs(result - expected) <= precision);
+    }
+  }
+}
+
+template<typename T>
+void assert_compiled_expressions_approximate_as_tree() {
+  const T abscissae[] = {-10, -2.5, -1, -0.5, 0, 0.5, 1, 2, 3.25, 100};
+  constexpr int n = sizeof(abscissae)/sizeof(T);
+  assert_compiled_expression_approximates_as_tree<T>("x^2-3*x+1", abscissae, n);
+  assert_compiled_expression_approximates_as_tree<T>("1/(x-1)", abscissae, n);
+  assert_compiled_expression_approximates_as_tree<T>("sin(x)*cos(2*x)+tan(x)", abscissae, n);
+  assert_compiled_expression_approximates_as_tree<T>("sin(x)", abscissae, n, true, Degree);
+  assert_compiled_expression_approximates_as_tree<T>("cos(90*x)", abscissae, n, true, Degree);
+  assert_compiled_expression_approximates_as_tree<T>("P*x+X^(x/10)", abscissae, n);
+  assert_compiled_expression_approximates_as_tree<T>("abs(x)-floor(x)+ceil(x)+frac(x)", abscissae, n);
+  assert_compiled_expression_approximates_as_tree<T>("sinh(x)+cosh(x)-tanh(x)", abscissae, n);
+  assert_compiled_expression_approximates_as_tree<T>("atan(x)+ln(abs(x)+1)", abscissae, n);
+  // Out of the real domain: these fall back on the tree approximation
+  assert_compiled_expression_approximates_as_tree<T>("R(x)", abscissae, n);
+  assert_compiled_expression_approximates_as_tree<T>("ln(x)+log(x)", abscissae, n);
+  assert_compiled_expression_approximates_as_tree<T>("asin(x)+acos(x/2)", abscissae, n);
+  assert_compiled_expression_approximates_as_tree<T>("x^(1/3)", abscissae, n);
+  assert_compiled_expression_approximates_as_tree<T>("root(x,3)", abscissae, n);
+  // Not compiled
+  assert_compiled_expression_approximates_as_tree<T>("im(x+I)", abscissae, n, false);
+  assert_compiled_expression_approximates_as_tree<T>("x+I", abscissae, n, false);
+  assert_compiled_expression_approximates_as_tree<T>("[[x,1]]", abscissae, n, false);
+}
+
+QUIZ_CASE(poincare_compiled_expression) {
+  assert_compiled_expressions_approximate_as_tree<float>();
+  assert_compiled_expressions_approximate_as_tree<double>();
+}
+
+template<typename T>
+void assert_batch_approximation_is_scalar_approximation(const char * expression) {
+  GlobalContext globalContext;
+  char buffer[200];
+  strlcpy(buffer, expression, sizeof(buffer));
+  translate_in_special_chars(buffer);
+  Expression e = Expression::ParseAndSimplify(buffer, globalContext, Radian);
+  // More values than a batch, to check the batch boundaries
+  constexpr int n = 40;
+  T abscissae[n];
+  T results[n];
+  for (int i = 0; i < n; i++) {
+    abscissae[i] = (T)(i-20)/(T)4;
+  }
+  e.approximateWithValuesForSymbol<T>('x', abscissae, results, n, globalContext, Radian);
+  CompiledExpression<T> c(e, 'x', globalContext, Radian);
+  for (int i = 0; i < n; i++) {
+    T expected = c.approximateWithValueForSymbol(abscissae[i], globalContext);
+    quiz_assert(results[i] == expected || (std::isnan(results[i]) && std::isnan(expected)));
+  }
+}
+
+QUIZ_CASE(poincare_compiled_expression_batch) {
+  assert_batch_approximation_is_scalar_approximation<float>("x^2-3*x+1");
+  assert_batch_approximation_is_scalar_approximation<double>("x^2-3*x+1");
+  assert_batch_approximation_is_scalar_approximation<float>("sin(x)/x+X^x");
+  assert_batch_approximation_is_scalar_approximation<double>("sin(x)/x+X^x");
+  assert_batch_approximation_is_scalar_approximation<double>("R(x)+ln(x)");
+  assert_batch_approximation_is_scalar_approximation<double>("1/(1/x)");
+  assert_batch_approximation_is_scalar_approximation<double>("im(x+I)");
+}
+
+QUIZ_CASE(poincare_compiled_expression_context_symbol) {
+  /* Symbols other than the variable are looked up in the context at each
+   * approximation. */
+  GlobalContext globalContext;
+  globalContext.setExpressionForSymbolName(Rational(3), Symbol('A'), globalContext);
+  Expression e = Expression::parse("A*x+1");
+  CompiledExpression<double> c(e, 'x', globalContext, Radian);
+  quiz_assert(c.approximateWithValueForSymbol(2.0, globalContext) == e.approximateWithValueForSymbol('x', 2.0, globalContext, Radian));
+  quiz_assert(std::fabs(c.approximateWithValueForSymbol(2.0, globalContext) - 7.0) < 1E-10);
+  globalContext.setExpressionForSymbolName(Rational(5), Symbol('A'), globalContext);
+  quiz_assert(std::fabs(c.approximateWithValueForSymbol(2.0, globalContext) - 11.0) < 1E-10);
+  globalContext.setExpressionForSymbolName(Expression(), Symbol('A'), globalContext);
+  // Too many symbols to compile
+  Expression f = Expression::parse("A+B+C+D+E*x");
+  CompiledExpression<double> d(f, 'x', globalContext, Radian);
+  quiz_assert(!d.isCompiled());
+}
+
+QUIZ_CASE(poincare_compiled_expression_uninitialized) {
+  GlobalContext globalContext;
+  CompiledExpression<float> c;
+  quiz_assert(c.isUninitialized());
+  quiz_assert(std::isnan(c.approximateWithValueForSymbol(1.0f, globalContext)));
+}
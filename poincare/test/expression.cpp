@@ -16,3 +16,34 @@ QUIZ_CASE(expression_can_be_copied_even_if_uninitialized) {
   Expression f;
   f = e;
 }
+
+QUIZ_CASE(expression_identity_tests_use_structural_hash) {
+  Expression e1 = Expression::parse("2*x+cos(y)");
+  Expression e2 = Expression::parse("2*x+cos(z)");
+  quiz_assert(!e1.isIdenticalTo(e2));
+  quiz_assert(e1.isIdenticalTo(e1.clone()));
+  // The cached hashes follow the changes of the descendants
+  e2.childAtIndex(1).childAtIndex(0).replaceWithInPlace(Symbol('y'));
+  quiz_assert(e1.isIdenticalTo(e2));
+  e2.childAtIndex(0).childAtIndex(0).replaceWithInPlace(Rational(3));
+  quiz_assert(!e1.isIdenticalTo(e2));
+  // Expressions of different types can be identical
+  quiz_assert(Power(Symbol('x'), Rational(1)).isIdenticalTo(Symbol('x')));
+  quiz_assert(Addition(Symbol('x')).isIdenticalTo(Symbol('x')));
+  quiz_assert(!Power(Symbol('x'), Rational(2)).isIdenticalTo(Symbol('x')));
+}
+
+QUIZ_CASE(expression_identity_tests_statistics) {
+  // The statistics are only counted in debug builds
+#if DEBUG
+  Expression e1 = Expression::parse("2*x+cos(y)");
+  Expression e2 = Expression::parse("2*x+cos(z)");
+  Expression::ResetIdentityTestsStatistics();
+  quiz_assert(!e1.isIdenticalTo(e2));
+  quiz_assert(Expression::NumberOfIdentityTests() == 1);
+  quiz_assert(Expression::NumberOfAvoidedComparisons() == 1);
+  quiz_assert(e1.isIdenticalTo(e1.clone()));
+  quiz_assert(Expression::NumberOfIdentityTests() == 2);
+  quiz_assert(Expression::NumberOfAvoidedComparisons() == 1);
+#endif
+}
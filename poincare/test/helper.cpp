@@ -29,35 +29,6 @@ const char * BigOverflowedIntegerString() {
   return s;
 }
 
-void translate_in_special_chars(char * expression) {
-  for (char *c = expression; *c; c++) {
-    switch (*c) {
-      case 'E': *c = Ion::Charset::Exponent; break;
-      case 'X': *c = Ion::Charset::Exponential; break;
-      case 'I': *c = Ion::Charset::IComplex; break;
-      case 'R': *c = Ion::Charset::Root; break;
-      case 'P': *c = Ion::Charset::SmallPi; break;
-      case '*': *c = Ion::Charset::MultiplicationSign; break;
-      case '>': *c = Ion::Charset::Sto; break;
-    }
-  }
-}
-
-void translate_in_ASCII_chars(char * expression) {
-  for (char *c = expression; *c; c++) {
-    switch (*c) {
-      case Ion::Charset::Exponent: *c = 'E'; break;
-      case Ion::Charset::Exponential: *c = 'X'; break;
-      case Ion::Charset::IComplex: *c = 'I'; break;
-      case Ion::Charset::Root: *c = 'R'; break;
-      case Ion::Charset::SmallPi: *c = 'P'; break;
-      case Ion::Charset::MultiplicationSign: *c = '*'; break;
-      case Ion::Charset::MiddleDot: *c = '*'; break;
-      case Ion::Charset::Sto: *c = '>'; break;
-    }
-  }
-}
-
 Expression parse_expression(const char * expression) {
   quiz_print(expression);
   char buffer[500];
@@ -1,4 +1,5 @@
 #include <poincare.h>
+#include "special_chars.h"
 
 // Expressions
 
@@ -13,8 +14,6 @@ constexpr Poincare::Preferences::ComplexFormat Polar = Poincare::Preferences::Co
 constexpr Poincare::Preferences::PrintFloatMode DecimalMode = Poincare::Preferences::PrintFloatMode::Decimal;
 constexpr Poincare::Preferences::PrintFloatMode ScientificMode = Poincare::Preferences::PrintFloatMode::Scientific;
 
-void translate_in_special_chars(char * expression);
-void translate_in_ASCII_chars(char * expression);
 Poincare::Expression parse_expression(const char * expression);
 void assert_parsed_expression_type(const char * expression, Poincare::ExpressionNode::Type type);
 void assert_parsed_expression_is(const char * expression, Poincare::Expression r);
@@ -78,6 +78,10 @@ QUIZ_CASE(poincare_integer_properties) {
   quiz_assert(!Integer(2).isNegative());
   quiz_assert(Integer(-2).isNegative());
   quiz_assert(Integer::NumberOfBase10DigitsWithoutSign(MaxInteger()) == 309);
+  quiz_assert(Integer::NumberOfBase10DigitsWithoutSign(Integer(0)) == 1);
+  quiz_assert(Integer::NumberOfBase10DigitsWithoutSign(Integer("999999999")) == 9);
+  quiz_assert(Integer::NumberOfBase10DigitsWithoutSign(Integer("-1000000000")) == 10);
+  quiz_assert(Integer::NumberOfBase10DigitsWithoutSign(Integer("1000000000000000000")) == 19);
 }
 
 static inline void assert_add_to(const Integer i, const Integer j, const Integer k) {
@@ -187,6 +191,12 @@ QUIZ_CASE(poincare_integer_divide) {
   assert_div_to(Integer("2305843009213693952"), Integer("2305843009213693921"), Integer("1"), Integer("31"));
   assert_div_to(MaxInteger(), MaxInteger(), Integer(1), Integer(0));
   assert_div_to(Integer("18446744073709551615"), Integer(10), Integer("1844674407370955161"), Integer(5));
+  // Quotient digit estimates that need to be corrected
+  assert_div_to(Integer("170141183420855150493001878992821682176"), Integer("39614081266355540842216685573"), Integer("4294967293"), Integer("39614081266355540837921718287"));
+  assert_div_to(Integer("5192138402209799099855309241319424"), Integer("1208907372870555465154561"), Integer("4294901758"), Integer("1208888926126477460701186"));
+  assert_div_to(Integer("340282366920938463463374607431768211455"), Integer("18446744073709551617"), Integer("18446744073709551615"), Integer(0));
+  assert_div_to(Integer("6277101735386680763835789423128438253588091106870490562565"), Integer("18446744073709551615"), Integer("340282366920938463481821351501182795776"), Integer("18446744069414584325"));
+  assert_div_to(Integer("10000000000000000000000000000000000000007"), Integer("100000000000000000003"), Integer("99999999999999999997"), Integer(16));
   assert_div_to(MaxInteger(), Integer(10), Integer("17976931348623159077293051907890247336179769789423065727343008115773267580550096313270847732240753602112011387987139335765878976881441662249284743063947412437776789342486548527630221960124609411945308295208500576883815068234246288147391311054082723716335051068458629823994724593847971630483535632962422413721"), Integer(5));
 }
 
@@ -197,6 +207,12 @@ static inline void assert_pow_to(const Integer i, const Integer j, const Integer
 QUIZ_CASE(poincare_integer_pow) {
   assert_pow_to(Integer(2), Integer(2), Integer(4));
   assert_pow_to(Integer("12345678910111213141516171819202122232425"), Integer(2), Integer("152415787751564791571474464067365843004067618915106260955633159458990465721380625"));
+  assert_pow_to(Integer(7), Integer(0), Integer(1));
+  assert_pow_to(Integer(-3), Integer(3), Integer(-27));
+  assert_pow_to(Integer(-3), Integer(4), Integer(81));
+  assert_pow_to(Integer(3), Integer(200), Integer("265613988875874769338781322035779626829233452653394495974574961739092490901302182994384699044001"));
+  quiz_assert(Integer::Power(Integer(2), Integer(1024)).isInfinity());
+  assert_pow_to(Integer(1), MaxInteger(), Integer(1));
 }
 
 static inline void assert_factorial_to(const Integer i, const Integer j) {
@@ -267,6 +283,9 @@ QUIZ_CASE(poincare_integer_serialize) {
   assert_integer_serializes_to(Integer(-2), "-2");
   assert_integer_serializes_to(Integer("2345678909876"), "2345678909876");
   assert_integer_serializes_to(Integer("-2345678909876"), "-2345678909876");
+  assert_integer_serializes_to(Integer("1000000000"), "1000000000");
+  assert_integer_serializes_to(Integer("-1000000000000000000001"), "-1000000000000000000001");
+  assert_integer_serializes_to(Integer("999999999000000000999999999"), "999999999000000000999999999");
   assert_integer_serializes_to(MaxInteger(), MaxIntegerString());
   assert_integer_serializes_to(OverflowedInteger(), "inf");
 }
@@ -0,0 +1,94 @@
+#include <quiz.h>
+#include <poincare.h>
+#include <poincare/exception_checkpoint.h>
+#include <poincare/integer_digit_arena.h>
+#include <assert.h>
+
+#include "helper.h"
+
+using namespace Poincare;
+
+QUIZ_CASE(poincare_integer_digit_arena_alloc) {
+  int initialNumberOfUsedBlocks = IntegerDigitArena::NumberOfUsedBlocks();
+  uint32_t * a = IntegerDigitArena::Alloc(2);
+  uint32_t * b = IntegerDigitArena::Alloc(IntegerDigitArena::k_maxNumberOfDigitsInBlock);
+  quiz_assert(a != b);
+  quiz_assert(IntegerDigitArena::NumberOfUsedBlocks() == initialNumberOfUsedBlocks + 2);
+  IntegerDigitArena::Free(a);
+  // The block which has just been freed is given back first
+  quiz_assert(IntegerDigitArena::Alloc(1) == a);
+  IntegerDigitArena::Free(a);
+  IntegerDigitArena::Free(b);
+  quiz_assert(IntegerDigitArena::NumberOfUsedBlocks() == initialNumberOfUsedBlocks);
+}
+
+QUIZ_CASE(poincare_integer_digit_arena_falls_back_on_larger_blocks) {
+  int initialNumberOfUsedBlocks = IntegerDigitArena::NumberOfUsedBlocks();
+  constexpr int numberOfAllocations = 80;
+  uint32_t * digits[numberOfAllocations];
+  for (int i = 0; i < numberOfAllocations; i++) {
+    digits[i] = IntegerDigitArena::Alloc(2);
+    digits[i][0] = i;
+    digits[i][1] = i;
+  }
+  for (int i = 0; i < numberOfAllocations; i++) {
+    quiz_assert(digits[i][0] == (uint32_t)i && digits[i][1] == (uint32_t)i);
+    IntegerDigitArena::Free(digits[i]);
+  }
+  quiz_assert(IntegerDigitArena::NumberOfUsedBlocks() == initialNumberOfUsedBlocks);
+}
+
+QUIZ_CASE(poincare_integer_digit_arena_holds_largest_integers) {
+  int initialNumberOfUsedBlocks = IntegerDigitArena::NumberOfUsedBlocks();
+  IntegerDigitArena::ResetPeakNumberOfUsedBlocks();
+  {
+    Integer max(MaxIntegerString());
+    Integer integers[Integer::k_maxNumberOfIntegerSimutaneously-1];
+    for (int i = 0; i < Integer::k_maxNumberOfIntegerSimutaneously-1; i++) {
+      integers[i] = max;
+    }
+    for (int i = 0; i < Integer::k_maxNumberOfIntegerSimutaneously-1; i++) {
+      quiz_assert(integers[i].isEqualTo(max));
+    }
+  }
+  quiz_assert(IntegerDigitArena::PeakNumberOfUsedBlocks() >= initialNumberOfUsedBlocks + Integer::k_maxNumberOfIntegerSimutaneously);
+  quiz_assert(IntegerDigitArena::NumberOfUsedBlocks() == initialNumberOfUsedBlocks);
+}
+
+QUIZ_CASE(poincare_integer_digit_arena_exhaustion) {
+  int initialNumberOfUsedBlocks = IntegerDigitArena::NumberOfUsedBlocks();
+  bool exhaustionHasBeenHandled = false;
+  Poincare::ExceptionCheckpoint ecp;
+  if (ExceptionRun(ecp)) {
+    while (true) {
+      IntegerDigitArena::Alloc(IntegerDigitArena::k_maxNumberOfDigitsInBlock);
+    }
+  } else {
+    exhaustionHasBeenHandled = true;
+  }
+  quiz_assert(exhaustionHasBeenHandled);
+  // The blocks leaked by the unwound frames are freed by the checkpoint
+  quiz_assert(IntegerDigitArena::NumberOfUsedBlocks() == initialNumberOfUsedBlocks);
+}
+
+QUIZ_CASE(poincare_integer_digit_arena_rollback_keeps_outer_integers) {
+  int initialNumberOfUsedBlocks = IntegerDigitArena::NumberOfUsedBlocks();
+  {
+    Integer max(MaxIntegerString());
+    Integer outer = max;
+    {
+      Poincare::ExceptionCheckpoint ecp;
+      if (ExceptionRun(ecp)) {
+        // Integers of the unwound frames leak their digits
+        Integer inner("123456789123456789123");
+        while (true) {
+          IntegerDigitArena::Alloc(IntegerDigitArena::k_maxNumberOfDigitsInBlock);
+        }
+      }
+    }
+    // The digits of the Integers allocated before the checkpoint are kept
+    quiz_assert(outer.isEqualTo(max));
+    quiz_assert(IntegerDigitArena::NumberOfUsedBlocks() == initialNumberOfUsedBlocks + 2);
+  }
+  quiz_assert(IntegerDigitArena::NumberOfUsedBlocks() == initialNumberOfUsedBlocks);
+}
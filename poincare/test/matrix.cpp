@@ -12,6 +12,16 @@ QUIZ_CASE(poincare_matrix_evaluate) {
 #endif
 }
 
+QUIZ_CASE(poincare_matrix_complex_evaluate) {
+  assert_parsed_expression_evaluates_to<double>("[[1,2,3][4,5,6]]+[[6,5,4][3,2,1]]", "[[7,7,7][7,7,7]]");
+  assert_parsed_expression_evaluates_to<double>("2-[[0,1][2,3]]", "[[2,1][0,-1]]");
+  assert_parsed_expression_evaluates_to<double>("-[[0,1]]", "[[0,-1]]");
+  assert_parsed_expression_evaluates_to<double>("transpose([[1,2,3][4,5,6]])", "[[1,4][2,5][3,6]]");
+  assert_parsed_expression_evaluates_to<double>("[[1,2,3][4,5,6]]*[[1][1][1]]", "[[6][15]]");
+  assert_parsed_expression_evaluates_to<double>("[[1,2][3,4]]*[[1,2,3]]", "undef");
+  assert_parsed_expression_evaluates_to<double>("abs([[1,-2,3,-4,5,-6,7,-8,9,-10,11,-12]])", "[[1,2,3,4,5,6,7,8,9,10,11,12]]");
+}
+
 QUIZ_CASE(poincare_matrix_simplify) {
 #if MATRICES_ARE_DEFINED
 #if MATRIX_EXACT_REDUCING
@@ -21,6 +21,13 @@ QUIZ_CASE(poincare_power_evaluate) {
 #if MATRICES_ARE_DEFINED
   assert_parsed_expression_evaluates_to<float>("[[1,2][3,4]]^(-3)", "[[-14.75,6.75][10.125,-4.625]]", Degree, Cartesian, 6);
   assert_parsed_expression_evaluates_to<double>("[[1,2][3,4]]^3", "[[37,54][81,118]]");
+  assert_parsed_expression_evaluates_to<double>("[[1,1][1,0]]^30", "[[1346269,832040][832040,514229]]");
+  assert_parsed_expression_evaluates_to<double>("[[0,1,0,0,0][0,0,1,0,0][0,0,0,1,0][0,0,0,0,1][1,0,0,0,0]]^100", "[[1,0,0,0,0][0,1,0,0,0][0,0,1,0,0][0,0,0,1,0][0,0,0,0,1]]");
+  assert_parsed_expression_evaluates_to<double>("[[0,1,0,0,0][0,0,1,0,0][0,0,0,1,0][0,0,0,0,1][1,0,0,0,0]]^101", "[[0,1,0,0,0][0,0,1,0,0][0,0,0,1,0][0,0,0,0,1][1,0,0,0,0]]");
+  assert_parsed_expression_evaluates_to<double>("[[2,0][0,4]]^(-2)", "[[0.25,0][0,0.0625]]");
+  assert_parsed_expression_evaluates_to<double>("[[2,0,0,0,0,0,0,0][0,2,0,0,0,0,0,0][0,0,2,0,0,0,0,0][0,0,0,2,0,0,0,0][0,0,0,0,2,0,0,0][0,0,0,0,0,2,0,0][0,0,0,0,0,0,2,0][0,0,0,0,0,0,0,2]]^(-1)", "[[0.5,0,0,0,0,0,0,0][0,0.5,0,0,0,0,0,0][0,0,0.5,0,0,0,0,0][0,0,0,0.5,0,0,0,0][0,0,0,0,0.5,0,0,0][0,0,0,0,0,0.5,0,0][0,0,0,0,0,0,0.5,0][0,0,0,0,0,0,0,0.5]]");
+  // More coefficients than the flat arrays can hold
+  assert_parsed_expression_evaluates_to<double>("[[2,0,0,0,0,0,0,0,0,0,0][0,1,0,0,0,0,0,0,0,0,0][0,0,1,0,0,0,0,0,0,0,0][0,0,0,1,0,0,0,0,0,0,0][0,0,0,0,1,0,0,0,0,0,0][0,0,0,0,0,1,0,0,0,0,0][0,0,0,0,0,0,1,0,0,0,0][0,0,0,0,0,0,0,1,0,0,0][0,0,0,0,0,0,0,0,1,0,0][0,0,0,0,0,0,0,0,0,1,0][0,0,0,0,0,0,0,0,0,0,1]]^3", "[[8,0,0,0,0,0,0,0,0,0,0][0,1,0,0,0,0,0,0,0,0,0][0,0,1,0,0,0,0,0,0,0,0][0,0,0,1,0,0,0,0,0,0,0][0,0,0,0,1,0,0,0,0,0,0][0,0,0,0,0,1,0,0,0,0,0][0,0,0,0,0,0,1,0,0,0,0][0,0,0,0,0,0,0,1,0,0,0][0,0,0,0,0,0,0,0,1,0,0][0,0,0,0,0,0,0,0,0,1,0][0,0,0,0,0,0,0,0,0,0,1]]");
 #endif
   assert_parsed_expression_evaluates_to<float>("0^2", "0");
   assert_parsed_expression_evaluates_to<double>("I^I", "2.0787957635076E-1");
@@ -82,9 +89,8 @@ QUIZ_CASE(poincare_power_simplify) {
    * k_maxNumberOfPrimeFactors and thus it prime decomposition might overflow
    * 32 factors. */
   assert_parsed_expression_simplify_to("1881676377434183981909562699940347954480361860897069^(1/3)", "root(1881676377434183981909562699940347954480361860897069,3)");
-  /* This does not reduce but should not as the prime decomposition involves
-   * factors above k_maxNumberOfPrimeFactors. */
-  assert_parsed_expression_simplify_to("1002101470343^(1/3)", "root(1002101470343,3)");
+  // 1002101470343 = 10007^3, a prime factor above the primes table
+  assert_parsed_expression_simplify_to("1002101470343^(1/3)", "10007");
   assert_parsed_expression_simplify_to("P*P*P", "P^3");
   assert_parsed_expression_simplify_to("(x+P)^(3)", "x^3+3*x^2*P+3*x*P^2+P^3");
   assert_parsed_expression_simplify_to("(5+R(2))^(-8)", "(1446241-1003320*R(2))/78310985281");
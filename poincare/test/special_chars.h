@@ -0,0 +1,11 @@
+#ifndef POINCARE_TEST_SPECIAL_CHARS_H
+#define POINCARE_TEST_SPECIAL_CHARS_H
+
+/* Special characters are written in ASCII in the tests: P for π, X for e, I
+ * for i, R for √, E for the exponent of decimals and > for the store arrow.
+ * These do not depend on quiz, so that the batch driver can share them. */
+
+void translate_in_special_chars(char * expression);
+void translate_in_ASCII_chars(char * expression);
+
+#endif
@@ -0,0 +1,61 @@
+#include <quiz.h>
+#include <poincare.h>
+#include <thread>
+#include <string.h>
+#include "helper.h"
+
+using namespace Poincare;
+
+static const char * const sExpressions[] = {
+  "2^100*3^50",
+  "(x+1)*(x+2)-x^2",
+  "1/(R(2)+R(3))",
+  "binomial(20,10)/5!",
+  "ln(8)/ln(2)+cos(P/3)",
+  "[[1,2][3,4]]*[[x,0][0,x]]",
+  "1/0",
+};
+constexpr static int sNumberOfExpressions = sizeof(sExpressions)/sizeof(const char *);
+constexpr static int k_serializationSize = 200;
+
+// Simplify every expression in the pool of the calling thread
+static void simplify_expressions(char results[][k_serializationSize]) {
+  GlobalContext context;
+  for (int i = 0; i < sNumberOfExpressions; i++) {
+    char buffer[k_serializationSize];
+    strlcpy(buffer, sExpressions[i], sizeof(buffer));
+    translate_in_special_chars(buffer);
+    Expression e = Expression::parse(buffer);
+    e = e.simplify(context, Radian);
+    e.serialize(results[i], k_serializationSize);
+  }
+}
+
+QUIZ_CASE(poincare_thread_context) {
+  constexpr int numberOfThreads = 4;
+  char expected[sNumberOfExpressions][k_serializationSize];
+  simplify_expressions(expected);
+  int numberOfNodes = TreePool::sharedPool()->numberOfNodes();
+
+  char results[numberOfThreads][sNumberOfExpressions][k_serializationSize];
+  std::thread threads[numberOfThreads];
+  for (int t = 0; t < numberOfThreads; t++) {
+    threads[t] = std::thread([&results, t]() {
+        ThreadContext threadContext;
+        for (int repeat = 0; repeat < 10; repeat++) {
+          simplify_expressions(results[t]);
+        }
+      });
+  }
+  for (int t = 0; t < numberOfThreads; t++) {
+    threads[t].join();
+  }
+
+  // The workers did not touch the pool of the main thread
+  quiz_assert(TreePool::sharedPool()->numberOfNodes() == numberOfNodes);
+  for (int t = 0; t < numberOfThreads; t++) {
+    for (int i = 0; i < sNumberOfExpressions; i++) {
+      quiz_assert(strcmp(results[t][i], expected[i]) == 0);
+    }
+  }
+}
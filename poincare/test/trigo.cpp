@@ -104,10 +104,10 @@ QUIZ_CASE(poincare_trigo_evaluate) {
   assert_parsed_expression_evaluates_to<float>("acos(-32)", "180-238.2725*I", Degree);
   // On R*i
   assert_parsed_expression_evaluates_to<float>("acos(3*I)", "1.5708-1.8184*I", Radian, Cartesian, 5);
-  assert_parsed_expression_evaluates_to<float>("acos(3*I)", "89.9999-104.189*I", Degree, Cartesian, 6);
+  assert_parsed_expression_evaluates_to<float>("acos(3*I)", "90-104.19*I", Degree, Cartesian, 5);
   // Symmetry: odd on imaginary
   assert_parsed_expression_evaluates_to<float>("acos(-3*I)", "1.5708+1.8184*I", Radian, Cartesian, 5);
-  assert_parsed_expression_evaluates_to<float>("acos(-3*I)", "89.9999+104.189*I", Degree, Cartesian, 6);
+  assert_parsed_expression_evaluates_to<float>("acos(-3*I)", "90+104.19*I", Degree, Cartesian, 5);
   // On C
   assert_parsed_expression_evaluates_to<float>("acos(I-4)", "2.8894-2.0966*I", Radian, Cartesian, 5);
   assert_parsed_expression_evaluates_to<float>("acos(I-4)", "165.551-120.126*I", Degree, Cartesian, 6);
@@ -469,6 +469,7 @@ QUIZ_CASE(poincare_trigo_simplify) {
   assert_parsed_expression_simplify_to("acos(cos(12))", "12", Preferences::AngleUnit::Degree);
   assert_parsed_expression_simplify_to("acos(cos(720/7))", "720/7", Preferences::AngleUnit::Degree);
   // -- asin
+  assert_parsed_expression_simplify_to("asin(0)", "0");
   assert_parsed_expression_simplify_to("asin(-1/2)", "-P/6");
   assert_parsed_expression_simplify_to("asin(-1.2)", "-asin(6/5)");
   assert_parsed_expression_simplify_to("asin(sin(2/3))", "2/3");
@@ -487,6 +488,8 @@ QUIZ_CASE(poincare_trigo_simplify) {
   assert_parsed_expression_simplify_to("asin(sin(400))", "40", Preferences::AngleUnit::Degree);
   assert_parsed_expression_simplify_to("asin(sin(-180/7))", "-180/7", Preferences::AngleUnit::Degree);
   // -- atan
+  assert_parsed_expression_simplify_to("atan(0)", "0");
+  assert_parsed_expression_simplify_to("atan(0)", "0", Preferences::AngleUnit::Degree);
   assert_parsed_expression_simplify_to("atan(-1)", "-P/4");
   assert_parsed_expression_simplify_to("atan(-1.2)", "-atan(6/5)");
   assert_parsed_expression_simplify_to("atan(tan(2/3))", "2/3");
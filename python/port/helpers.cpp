@@ -11,6 +11,7 @@ void micropython_port_should_interrupt() {
     return;
   }
   c = 0;
+  micropython_port_flush_drawings();
   Ion::Keyboard::State scan = Ion::Keyboard::scan();
   if (scan.keyDown((Ion::Keyboard::Key)mp_interrupt_char)) {
     mp_keyboard_interrupt();
@@ -9,6 +9,10 @@ extern "C" {
  * if a key is down to raise an interruption flag. */
 void micropython_port_should_interrupt();
 
+/* flush_drawings pushes to the screen what the script drew with kandinsky when
+ * Escher draws in the compositor, and does nothing otherwise. */
+void micropython_port_flush_drawings();
+
 #ifdef __cplusplus
 }
 #endif
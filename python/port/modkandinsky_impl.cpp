@@ -3,12 +3,46 @@ extern "C" {
 }
 #include <kandinsky.h>
 #include "port.h"
+#include "helpers.h"
 
 /* KDIonContext::sharedContext needs to be set to the wanted Rect before
  * calling kandinsky_get_pixel, kandinsky_set_pixel and kandinsky_draw_string.
  * We do this here with displaySandbox(), which pushes the SandboxController on
  * the stackViewController and forces the window to redraw itself.
- * KDIonContext::sharedContext is set to the frame of the last object drawn. */
+ * KDIonContext::sharedContext is set to the frame of the last object drawn.
+ * When Escher draws in the compositor, the compositor is the context which is
+ * set. Flushing it after each drawing would scan the tiles and clear the frame
+ * statistics for every pixel drawn, so it is only flushed when the keyboard is scanned for an interruption, which
+ * acts as the frame rate of the script, and when the script ends. */
+
+#if ESCHER_COMPOSITOR
+static bool sSandboxHasChanged = false;
+
+static KDContext * sandboxContext() {
+  return KDCompositorContext::sharedContext();
+}
+
+static void sandboxContextDidChange() {
+  sSandboxHasChanged = true;
+}
+
+void micropython_port_flush_drawings() {
+  if (sSandboxHasChanged) {
+    KDCompositorContext::sharedContext()->flush();
+    sSandboxHasChanged = false;
+  }
+}
+#else
+static KDContext * sandboxContext() {
+  return KDIonContext::sharedContext();
+}
+
+static void sandboxContextDidChange() {
+}
+
+void micropython_port_flush_drawings() {
+}
+#endif
 
 mp_obj_t kandinsky_color(mp_obj_t red, mp_obj_t green, mp_obj_t blue) {
   return
@@ -22,7 +56,7 @@ mp_obj_t kandinsky_color(mp_obj_t red, mp_obj_t green, mp_obj_t blue) {
 }
 
 mp_obj_t kandinsky_get_pixel(mp_obj_t x, mp_obj_t y) {
-  KDColor c = KDIonContext::sharedContext()->getPixel(
+  KDColor c = sandboxContext()->getPixel(
     KDPoint(mp_obj_get_int(x), mp_obj_get_int(y))
   );
   return MP_OBJ_NEW_SMALL_INT(c);
@@ -30,19 +64,21 @@ mp_obj_t kandinsky_get_pixel(mp_obj_t x, mp_obj_t y) {
 
 mp_obj_t kandinsky_set_pixel(mp_obj_t x, mp_obj_t y, mp_obj_t color) {
   MicroPython::ExecutionEnvironment::currentExecutionEnvironment()->displaySandbox();
-  KDIonContext::sharedContext()->setPixel(
+  sandboxContext()->setPixel(
     KDPoint(mp_obj_get_int(x), mp_obj_get_int(y)),
     KDColor::RGB16(mp_obj_get_int(color))
   );
+  sandboxContextDidChange();
   return mp_const_none;
 }
 
 mp_obj_t kandinsky_draw_string(mp_obj_t text, mp_obj_t x, mp_obj_t y) {
   MicroPython::ExecutionEnvironment::currentExecutionEnvironment()->displaySandbox();
-  KDIonContext::sharedContext()->drawString(
+  sandboxContext()->drawString(
     mp_obj_str_get_str(text),
     KDPoint(mp_obj_get_int(x), mp_obj_get_int(y))
   );
+  sandboxContextDidChange();
   return mp_const_none;
 }
 
@@ -1,4 +1,5 @@
 #include "port.h"
+#include "helpers.h"
 
 #include <ion/keyboard.h>
 
@@ -80,6 +81,7 @@ void MicroPython::ExecutionEnvironment::runCode(const char * str) {
     mp_print_str(&mp_plat_print, "\n");
     /* End of mp_obj_print_exception. */
   }
+  micropython_port_flush_drawings();
 
   assert(sCurrentExecutionEnvironment == this);
   sCurrentExecutionEnvironment = nullptr;
@@ -0,0 +1,29 @@
+#ifndef QUIZ_BENCHMARK_H
+#define QUIZ_BENCHMARK_H
+
+/* Benchmarks are quiz cases which are only built on demand, on host platforms:
+ *   make PLATFORM=blackbox QUIZ_USE_CONSOLE=1 QUIZ_BENCHMARKS=1 test.bin
+ * They measure wall-clock time and report it through quiz_print. */
+
+#include <quiz.h>
+#include <chrono>
+#include <stdio.h>
+
+/* Return the mean duration of one call to f, in nanoseconds. */
+template<typename F>
+double quiz_benchmark(int numberOfIterations, F f) {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numberOfIterations; i++) {
+    f();
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count()/numberOfIterations;
+}
+
+inline void quiz_benchmark_print(const char * name, double reference, double optimized) {
+  char buffer[128];
+  snprintf(buffer, sizeof(buffer), "%s: %.0f ns -> %.0f ns (x%.1f)", name, reference, optimized, reference/optimized);
+  quiz_print(buffer);
+}
+
+#endif